@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+// Evaluation worker for process_evaluator answering every request with its own specimen,
+// which makes the specimen its rating. Given a number, it exits after answering that many
+// requests, to exercise the restarting of workers, or stops answering when also given "hang",
+// to exercise timeouts.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+int main(int argc, char* argv[]) {
+	std::ios::sync_with_stdio(false);
+	const unsigned long long exit_after = argc > 1 ? std::stoull(argv[1]) : 0;
+	const bool hang = argc > 2 && std::string(argv[2]) == "hang";
+	std::string line;
+	for (unsigned long long answered = 0; std::getline(std::cin, line); answered++) {
+		if (exit_after > 0 && answered == exit_after) {
+			std::cout.flush();
+			while (hang) {
+				std::this_thread::sleep_for(std::chrono::hours(1));
+			}
+			std::_Exit(EXIT_FAILURE);
+		}
+		std::cout << line << '\n';
+		if (std::cin.rdbuf()->in_avail() <= 0)
+			std::cout.flush();
+	}
+	return 0;
+}
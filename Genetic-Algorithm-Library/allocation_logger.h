@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_ALLOCATION_LOGGER_H
+#define GENETIC_ALGORITHM_LIBRARY_ALLOCATION_LOGGER_H
+
+#include <ostream>
+#include "counting_resource.h"
+
+/// Observer writing the allocations made through a \c counting_resource since the previous stage.
+/**
+The counts reported with a stage are those of the work that produced it,
+so a stage that reports no allocations ran entirely on reused memory.
+*/
+template<class CharT, class Traits>
+class allocation_logger {
+public:
+	using ostream_type = std::basic_ostream<CharT, Traits>;
+	allocation_logger(const counting_resource& resource, ostream_type& out);
+	allocation_logger(const counting_resource& resource, ostream_type&&) = delete;
+	template<class Algorithm>
+	void operator()(const Algorithm&, typename Algorithm::stage_type stage, const typename Algorithm::population_type&);
+private:
+	const counting_resource& resource;
+	ostream_type& out;
+	counting_resource::statistics_type last;
+};
+
+template<class CharT, class Traits>
+inline allocation_logger<CharT, Traits>::allocation_logger(const counting_resource& resource, ostream_type& out)
+	: resource(resource), out(out), last(resource.statistics()) {}
+
+template<class CharT, class Traits>
+template<class Algorithm>
+inline void allocation_logger<CharT, Traits>::operator()(const Algorithm&, typename Algorithm::stage_type stage, const typename Algorithm::population_type&) {
+	using stage_type = typename Algorithm::stage_type;
+	const counting_resource::statistics_type current = resource.statistics();
+	switch (stage) {
+		case stage_type::generated:
+			out << "Generating";
+			break;
+		case stage_type::selected:
+			out << "Selecting";
+			break;
+		case stage_type::bred:
+			out << "Breeding";
+			break;
+	}
+	out << " made " << current.allocations - last.allocations << " allocations of " << current.bytes_allocated - last.bytes_allocated << " bytes and " << current.deallocations - last.deallocations << " deallocations\n";
+	last = current;
+}
+
+#endif
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_BATCH_MUTATION_H
+#define GENETIC_ALGORITHM_LIBRARY_BATCH_MUTATION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include <gsl/span>
+#include "bulk_random.h"
+#include "evaluated_specimen.h"
+#include "random_stream_family.h"
+#include "xoshiro256_star_star.h"
+
+template<class Specimen, class Rating>
+constexpr Specimen& mutable_value(evaluated_specimen<Specimen, Rating>& specimen) noexcept {
+	return specimen.value();
+}
+
+template<class Specimen>
+constexpr Specimen& mutable_value(Specimen& specimen) noexcept {
+	return specimen;
+}
+
+/// Mutates every specimen of a population independently with a fixed probability.
+/**
+Instead of tossing a coin for each specimen, the distance to the next
+mutated specimen is drawn from the geometric distribution, so the number
+of random draws is proportional to the number of mutations rather than
+to the size of the population. The chosen specimens are then handed to
+the mutator using \a ExecutionPolicy. With a parallel policy the mutator
+has to be safe to call concurrently. Every chosen specimen is then also
+given a seed drawn in order from \a g, and is mutated with a
+\c xoshiro256_star_star seeded with it bound to the
+\c task_random_bit_generator of the thread, so a mutator drawing from
+that generator mutates the population the same way whatever the number
+of threads and their scheduling.
+
+@tparam ExecutionPolicy Policy used to apply the mutator to the chosen specimens
+*/
+template<class UniformRandomBitGenerator, class Mutator, class ExecutionPolicy = std::execution::sequenced_policy>
+class batch_mutation {
+public:
+	batch_mutation(UniformRandomBitGenerator& g, double probability, const Mutator& mutator, const ExecutionPolicy& policy = ExecutionPolicy());
+	template<class Population>
+	void operator()(Population& specimens);
+private:
+	std::size_t skip(std::size_t bound);
+	UniformRandomBitGenerator& rand;
+	double probability;
+	double log_complement;
+	Mutator mutator;
+	ExecutionPolicy policy;
+	std::pmr::vector<std::size_t> chosen;
+	std::pmr::vector<std::uint64_t> seeds;
+	std::pmr::vector<std::pair<std::size_t, std::uint64_t>> tasks;
+};
+
+template<class UniformRandomBitGenerator, class Mutator, class ExecutionPolicy>
+inline batch_mutation<UniformRandomBitGenerator, Mutator, ExecutionPolicy>::batch_mutation(UniformRandomBitGenerator& g, double probability, const Mutator& mutator, const ExecutionPolicy& policy)
+	: rand(g), probability(probability), log_complement(std::log1p(-probability)), mutator(mutator), policy(policy) {
+	Expects(probability >= 0.0 && probability <= 1.0);
+}
+
+template<class UniformRandomBitGenerator, class Mutator, class ExecutionPolicy>
+template<class Population>
+inline void batch_mutation<UniformRandomBitGenerator, Mutator, ExecutionPolicy>::operator()(Population& specimens) {
+	const std::size_t size = specimens.size();
+	chosen.clear();
+	if (probability <= 0.0)
+		return;
+	for (std::size_t i = skip(size); i < size; i += skip(size - i - 1) + 1) {
+		chosen.push_back(i);
+	}
+	if constexpr (std::is_same_v<ExecutionPolicy, std::execution::sequenced_policy>) {
+		for (const std::size_t index : chosen) {
+			mutator(mutable_value(specimens[index]));
+		}
+	} else {
+		seeds.resize(chosen.size());
+		generate_bits(rand, gsl::span<std::uint64_t>(seeds));
+		tasks.resize(chosen.size());
+		std::transform(chosen.begin(), chosen.end(), seeds.begin(), tasks.begin(), [](std::size_t index, std::uint64_t seed) {
+			return std::make_pair(index, seed);
+		});
+		std::for_each(policy, tasks.begin(), tasks.end(), [&](const std::pair<std::size_t, std::uint64_t>& task) {
+			xoshiro256_star_star engine(task.second);
+			typename task_random_bit_generator<xoshiro256_star_star>::binding bound(engine);
+			mutator(mutable_value(specimens[task.first]));
+		});
+	}
+}
+
+template<class UniformRandomBitGenerator, class Mutator, class ExecutionPolicy>
+inline std::size_t batch_mutation<UniformRandomBitGenerator, Mutator, ExecutionPolicy>::skip(std::size_t bound) {
+	if (probability >= 1.0 || bound == 0)
+		return 0;
+	std::uint64_t bits;
+	generate_bits(rand, gsl::span<std::uint64_t>(&bits, 1));
+	const double gap = std::floor(std::log1p(-to_unit_interval(bits)) / log_complement);
+	return gap < static_cast<double>(bound) ? static_cast<std::size_t>(gap) : bound;
+}
+
+#endif
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_BOUNDED_SELECTION_H
+#define GENETIC_ALGORITHM_LIBRARY_BOUNDED_SELECTION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+
+/// Keeps the \a n best of a stream of specimens offered one at a time.
+/**
+The kept specimens stay in place while a heap of (key, index) pairs tracks
+which of them is the first to be replaced, so a candidate costs a single
+comparison unless it displaces one of the kept specimens. A new stream
+starts whenever a candidate is offered to an empty vector.
+
+@tparam Key Type of the sort keys
+*/
+template<class Key>
+class bounded_selection {
+public:
+	using key_type = Key;
+	explicit bounded_selection(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+	template<class Specimen, class Allocator, class Compare>
+	void operator()(std::vector<Specimen, Allocator>& kept, std::size_t n, Specimen&& candidate, const key_type& key, Compare comp);
+private:
+	struct entry {
+		key_type key;
+		std::size_t index;
+	};
+	std::pmr::vector<entry> entries;
+};
+
+template<class Key>
+inline bounded_selection<Key>::bounded_selection(std::pmr::memory_resource* resource)
+	: entries(resource) {}
+
+template<class Key>
+template<class Specimen, class Allocator, class Compare>
+inline void bounded_selection<Key>::operator()(std::vector<Specimen, Allocator>& kept, std::size_t n, Specimen&& candidate, const key_type& key, Compare comp) {
+	if (kept.empty())
+		entries.clear();
+	Expects(entries.size() == kept.size());
+	Expects(kept.size() <= n);
+	const auto precedes = [&](const entry& lhs, const entry& rhs) {
+		return comp(lhs.key, rhs.key);
+	};
+	if (kept.size() < n) {
+		entries.push_back({key, kept.size()});
+		kept.push_back(std::move(candidate));
+		std::push_heap(entries.begin(), entries.end(), precedes);
+	} else if (n > 0 && comp(key, entries.front().key)) {
+		std::pop_heap(entries.begin(), entries.end(), precedes);
+		entries.back().key = key;
+		kept[entries.back().index] = std::move(candidate);
+		std::push_heap(entries.begin(), entries.end(), precedes);
+	}
+}
+
+#endif
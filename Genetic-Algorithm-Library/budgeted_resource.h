@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_BUDGETED_RESOURCE_H
+#define GENETIC_ALGORITHM_LIBRARY_BUDGETED_RESOURCE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include "mapped_file_resource.h"
+
+/// Memory resource keeping at most \a budget bytes in memory and spilling the rest to a mapped file.
+/**
+Blocks are taken from \a upstream as long as they fit in the budget and
+from the file once it is used up, until enough of them are freed. Which
+blocks stay in memory is decided when they are allocated, not by how
+recently they are used; under memory pressure the operating system
+evicts the pages of the file it has touched least recently. Installing
+it as the default resource makes every \c std::pmr container, including
+the storage of specimens that use one, subject to the budget.
+*/
+class budgeted_resource : public std::pmr::memory_resource {
+public:
+	budgeted_resource(std::size_t budget, mapped_file_resource& spill, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept;
+	std::size_t budget() const noexcept;
+	std::size_t resident() const noexcept;
+private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	std::size_t limit;
+	std::atomic<std::size_t> used {0};
+	mapped_file_resource& spill;
+	std::pmr::memory_resource* upstream;
+};
+
+inline budgeted_resource::budgeted_resource(std::size_t budget, mapped_file_resource& spill, std::pmr::memory_resource* upstream) noexcept
+	: limit(budget), spill(spill), upstream(upstream) {}
+
+inline std::size_t budgeted_resource::budget() const noexcept {
+	return limit;
+}
+
+inline std::size_t budgeted_resource::resident() const noexcept {
+	return used.load(std::memory_order_relaxed);
+}
+
+inline void* budgeted_resource::do_allocate(std::size_t bytes, std::size_t alignment) {
+	if (used.fetch_add(bytes, std::memory_order_relaxed) + bytes <= limit) {
+		try {
+			return upstream->allocate(bytes, alignment);
+		} catch (...) {
+			used.fetch_sub(bytes, std::memory_order_relaxed);
+			throw;
+		}
+	}
+	used.fetch_sub(bytes, std::memory_order_relaxed);
+	return spill.allocate(bytes, alignment);
+}
+
+inline void budgeted_resource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+	if (spill.contains(p)) {
+		spill.deallocate(p, bytes, alignment);
+	} else {
+		upstream->deallocate(p, bytes, alignment);
+		used.fetch_sub(bytes, std::memory_order_relaxed);
+	}
+}
+
+inline bool budgeted_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
+
+#endif
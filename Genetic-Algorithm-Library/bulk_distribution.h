@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_BULK_DISTRIBUTION_H
+#define GENETIC_ALGORITHM_LIBRARY_BULK_DISTRIBUTION_H
+
+#include <array>
+#include <cstddef>
+#include <gsl/gsl_assert>
+#include <gsl/span>
+#include "bulk_random.h"
+
+/// A block of pregenerated samples handed out one at a time
+template<class T, std::size_t Size = 256>
+class variate_buffer {
+public:
+	template<class Function>
+	T next(Function refill);
+	void clear() noexcept;
+private:
+	alignas(64) std::array<T, Size> values {};
+	std::size_t position = Size;
+};
+
+template<class T, std::size_t Size>
+template<class Function>
+inline T variate_buffer<T, Size>::next(Function refill) {
+	if (position == Size) {
+		refill(gsl::span<T>(values));
+		position = 0;
+	}
+	return values[position++];
+}
+
+template<class T, std::size_t Size>
+inline void variate_buffer<T, Size>::clear() noexcept {
+	position = Size;
+}
+
+/// Normal distribution drawing its samples from blocks filled by \c generate_normal
+class bulk_normal_distribution {
+public:
+	using result_type = double;
+	explicit bulk_normal_distribution(double mean = 0.0, double stddev = 1.0);
+	template<class UniformRandomBitGenerator>
+	result_type operator()(UniformRandomBitGenerator& g);
+	void reset() noexcept;
+	double mean() const noexcept;
+	double stddev() const noexcept;
+private:
+	double mu;
+	double sigma;
+	variate_buffer<double> buffer;
+};
+
+inline bulk_normal_distribution::bulk_normal_distribution(double mean, double stddev)
+	: mu(mean), sigma(stddev) {
+	Expects(stddev > 0.0);
+}
+
+template<class UniformRandomBitGenerator>
+inline auto bulk_normal_distribution::operator()(UniformRandomBitGenerator& g) -> result_type {
+	return mu + sigma * buffer.next([&](gsl::span<double> values) {
+		generate_normal(g, values);
+	});
+}
+
+inline void bulk_normal_distribution::reset() noexcept {
+	buffer.clear();
+}
+
+inline double bulk_normal_distribution::mean() const noexcept {
+	return mu;
+}
+
+inline double bulk_normal_distribution::stddev() const noexcept {
+	return sigma;
+}
+
+/// Exponential distribution drawing its samples from blocks filled by \c generate_exponential
+class bulk_exponential_distribution {
+public:
+	using result_type = double;
+	explicit bulk_exponential_distribution(double lambda = 1.0);
+	template<class UniformRandomBitGenerator>
+	result_type operator()(UniformRandomBitGenerator& g);
+	void reset() noexcept;
+	double lambda() const noexcept;
+private:
+	double rate;
+	variate_buffer<double> buffer;
+};
+
+inline bulk_exponential_distribution::bulk_exponential_distribution(double lambda)
+	: rate(lambda) {
+	Expects(lambda > 0.0);
+}
+
+template<class UniformRandomBitGenerator>
+inline auto bulk_exponential_distribution::operator()(UniformRandomBitGenerator& g) -> result_type {
+	return buffer.next([&](gsl::span<double> values) {
+		generate_exponential(g, values);
+	}) / rate;
+}
+
+inline void bulk_exponential_distribution::reset() noexcept {
+	buffer.clear();
+}
+
+inline double bulk_exponential_distribution::lambda() const noexcept {
+	return rate;
+}
+
+/// Bernoulli distribution drawing its samples from blocks filled by \c generate_bernoulli
+class bulk_bernoulli_distribution {
+public:
+	using result_type = bool;
+	explicit bulk_bernoulli_distribution(double p = 0.5);
+	template<class UniformRandomBitGenerator>
+	result_type operator()(UniformRandomBitGenerator& g);
+	void reset() noexcept;
+	double p() const noexcept;
+private:
+	double probability;
+	variate_buffer<bool> buffer;
+};
+
+inline bulk_bernoulli_distribution::bulk_bernoulli_distribution(double p)
+	: probability(p) {
+	Expects(p >= 0.0 && p <= 1.0);
+}
+
+template<class UniformRandomBitGenerator>
+inline auto bulk_bernoulli_distribution::operator()(UniformRandomBitGenerator& g) -> result_type {
+	return buffer.next([&](gsl::span<bool> values) {
+		generate_bernoulli(g, probability, values);
+	});
+}
+
+inline void bulk_bernoulli_distribution::reset() noexcept {
+	buffer.clear();
+}
+
+inline double bulk_bernoulli_distribution::p() const noexcept {
+	return probability;
+}
+
+#endif
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_BULK_RANDOM_H
+#define GENETIC_ALGORITHM_LIBRARY_BULK_RANDOM_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <gsl/gsl_util>
+#include <gsl/span>
+
+/// Layer boundaries of a ziggurat covering the density \c f on [0, infinity)
+/**
+\c x[i] is the right edge of layer \a i and \c density[i] is f(x[i]), with
+\c x[0] being the width of the base layer stretched to a rectangle of the
+common layer area and \c x[Layers] equal to zero.
+*/
+template<std::size_t Layers>
+struct ziggurat_table {
+	static constexpr std::size_t layers = Layers;
+	std::array<double, Layers + 1> x;
+	std::array<double, Layers + 1> density;
+};
+
+template<std::size_t Layers, class Density, class InverseDensity>
+ziggurat_table<Layers> make_ziggurat_table(double r, double area, Density f, InverseDensity inverse) {
+	ziggurat_table<Layers> table;
+	table.x[0] = area / f(r);
+	table.x[1] = r;
+	for (std::size_t i = 1; i + 1 < Layers; i++) {
+		table.x[i + 1] = inverse(area / table.x[i] + f(table.x[i]));
+	}
+	table.x[Layers] = 0.0;
+	for (std::size_t i = 0; i <= Layers; i++) {
+		table.density[i] = f(table.x[i]);
+	}
+	return table;
+}
+
+inline const ziggurat_table<128>& normal_ziggurat() {
+	static const ziggurat_table<128> table = make_ziggurat_table<128>(3.442619855899, 9.91256303526217e-3, [](double x) {
+		return std::exp(-0.5 * x * x);
+	}, [](double y) {
+		return std::sqrt(-2.0 * std::log(y));
+	});
+	return table;
+}
+
+inline const ziggurat_table<256>& exponential_ziggurat() {
+	static const ziggurat_table<256> table = make_ziggurat_table<256>(7.69711747013104972, 3.949659822581572e-3, [](double x) {
+		return std::exp(-x);
+	}, [](double y) {
+		return -std::log(y);
+	});
+	return table;
+}
+
+constexpr double to_unit_interval(std::uint64_t bits) noexcept {
+	return static_cast<double>(bits >> 11) * 0x1.0p-53;
+}
+
+/// Fills \a out with uniformly distributed 64-bit words drawn from \a g
+template<class UniformRandomBitGenerator>
+void generate_bits(UniformRandomBitGenerator& g, gsl::span<std::uint64_t> out) {
+	using result_type = typename UniformRandomBitGenerator::result_type;
+	static_assert(UniformRandomBitGenerator::min() == 0, "the generator must produce full words");
+	std::uint64_t* const words = out.data();
+	const std::ptrdiff_t size = out.size();
+	if constexpr (UniformRandomBitGenerator::max() == std::numeric_limits<std::uint64_t>::max()) {
+		for (std::ptrdiff_t i = 0; i < size; i++) {
+			words[i] = g();
+		}
+	} else {
+		static_assert(UniformRandomBitGenerator::max() == std::numeric_limits<std::uint32_t>::max(), "the generator must produce 32 or 64-bit words");
+		for (std::ptrdiff_t i = 0; i < size; i++) {
+			const result_type high = g();
+			words[i] = (std::uint64_t(high) << 32) | std::uint64_t(g());
+		}
+	}
+}
+
+/// Fills \a out with samples uniformly distributed in [0, 1)
+template<class UniformRandomBitGenerator>
+void generate_uniform(UniformRandomBitGenerator& g, gsl::span<double> out) {
+	constexpr std::ptrdiff_t block_size = 256;
+	std::array<std::uint64_t, block_size> bits;
+	while (!out.empty()) {
+		const std::ptrdiff_t count = std::min(block_size, out.size());
+		generate_bits(g, gsl::span<std::uint64_t>(bits.data(), count));
+		double* const values = out.data();
+		for (std::ptrdiff_t i = 0; i < count; i++) {
+			values[i] = to_unit_interval(bits[i]);
+		}
+		out = out.subspan(count);
+	}
+}
+
+/// Fills \a out with Bernoulli trials succeeding with probability \a p
+template<class UniformRandomBitGenerator>
+void generate_bernoulli(UniformRandomBitGenerator& g, double p, gsl::span<bool> out) {
+	constexpr std::ptrdiff_t block_size = 256;
+	std::array<std::uint64_t, block_size> bits;
+	const bool certain = p >= 1.0;
+	const std::uint64_t threshold = p > 0.0 && !certain ? static_cast<std::uint64_t>(p * 0x1.0p64) : 0;
+	while (!out.empty()) {
+		const std::ptrdiff_t count = std::min(block_size, out.size());
+		generate_bits(g, gsl::span<std::uint64_t>(bits.data(), count));
+		bool* const values = out.data();
+		for (std::ptrdiff_t i = 0; i < count; i++) {
+			values[i] = certain || bits[i] < threshold;
+		}
+		out = out.subspan(count);
+	}
+}
+
+/// Draws one sample from the layer selected by the low bits of \a bits, retrying until accepted
+template<std::size_t Layers, class UniformRandomBitGenerator, class Density, class Tail>
+double ziggurat_sample(const ziggurat_table<Layers>& table, UniformRandomBitGenerator& g, std::uint64_t bits, Density f, Tail tail) {
+	while (true) {
+		const std::size_t layer = bits & (Layers - 1);
+		const double x = to_unit_interval(bits) * table.x[layer];
+		if (x < table.x[layer + 1])
+			return x;
+		if (layer == 0)
+			return tail(g);
+		std::uint64_t extra;
+		generate_bits(g, gsl::span<std::uint64_t>(&extra, 1));
+		const double y = table.density[layer] + to_unit_interval(extra) * (table.density[layer + 1] - table.density[layer]);
+		if (y < f(x))
+			return x;
+		generate_bits(g, gsl::span<std::uint64_t>(&bits, 1));
+	}
+}
+
+/// Fills \a out with samples of the standard normal distribution using the ziggurat method
+template<class UniformRandomBitGenerator>
+void generate_normal(UniformRandomBitGenerator& g, gsl::span<double> out) {
+	constexpr std::ptrdiff_t block_size = 256;
+	constexpr std::size_t layers = 128;
+	constexpr std::uint64_t sign_bit = layers;
+	const ziggurat_table<layers>& table = normal_ziggurat();
+	const double r = table.x[1];
+	const auto density = [](double x) {
+		return std::exp(-0.5 * x * x);
+	};
+	const auto tail = [r](UniformRandomBitGenerator& rand) {
+		std::uint64_t bits[2];
+		while (true) {
+			generate_bits(rand, gsl::span<std::uint64_t>(bits));
+			const double a = -std::log1p(-to_unit_interval(bits[0])) / r;
+			const double b = -std::log1p(-to_unit_interval(bits[1]));
+			if (b + b > a * a)
+				return r + a;
+		}
+	};
+	std::array<std::uint64_t, block_size> bits;
+	while (!out.empty()) {
+		const std::ptrdiff_t count = std::min(block_size, out.size());
+		generate_bits(g, gsl::span<std::uint64_t>(bits.data(), count));
+		double* const values = out.data();
+		for (std::ptrdiff_t i = 0; i < count; i++) {
+			const std::uint64_t word = bits[i];
+			const double x = to_unit_interval(word) * table.x[word & (layers - 1)];
+			values[i] = word & sign_bit ? -x : x;
+		}
+		for (std::ptrdiff_t i = 0; i < count; i++) {
+			const std::uint64_t word = bits[i];
+			if (std::abs(values[i]) >= table.x[(word & (layers - 1)) + 1]) {
+				const double x = ziggurat_sample(table, g, word, density, tail);
+				values[i] = word & sign_bit ? -x : x;
+			}
+		}
+		out = out.subspan(count);
+	}
+}
+
+/// Fills \a out with samples of the exponential distribution with rate 1 using the ziggurat method
+template<class UniformRandomBitGenerator>
+void generate_exponential(UniformRandomBitGenerator& g, gsl::span<double> out) {
+	constexpr std::ptrdiff_t block_size = 256;
+	constexpr std::size_t layers = 256;
+	const ziggurat_table<layers>& table = exponential_ziggurat();
+	const double r = table.x[1];
+	const auto density = [](double x) {
+		return std::exp(-x);
+	};
+	const auto tail = [r](UniformRandomBitGenerator& rand) {
+		std::uint64_t bits;
+		generate_bits(rand, gsl::span<std::uint64_t>(&bits, 1));
+		return r - std::log1p(-to_unit_interval(bits));
+	};
+	std::array<std::uint64_t, block_size> bits;
+	while (!out.empty()) {
+		const std::ptrdiff_t count = std::min(block_size, out.size());
+		generate_bits(g, gsl::span<std::uint64_t>(bits.data(), count));
+		double* const values = out.data();
+		for (std::ptrdiff_t i = 0; i < count; i++) {
+			const std::uint64_t word = bits[i];
+			values[i] = to_unit_interval(word) * table.x[word & (layers - 1)];
+		}
+		for (std::ptrdiff_t i = 0; i < count; i++) {
+			const std::uint64_t word = bits[i];
+			if (values[i] >= table.x[(word & (layers - 1)) + 1])
+				values[i] = ziggurat_sample(table, g, word, density, tail);
+		}
+		out = out.subspan(count);
+	}
+}
+
+#endif
@@ -28,11 +28,12 @@
 #include <cstddef>
 #include <utility>
 #include <tuple>
+#include <type_traits>
 
 template<class... Mutations>
 class chain_mutation {
 public:
-	explicit chain_mutation(Mutations&&... mutations) noexcept(noexcept(Mutations(std::forward<Mutations>(mutations)...)));
+	explicit chain_mutation(Mutations&&... mutations) noexcept((std::is_nothrow_move_constructible_v<Mutations> && ...));
 	template<class T>
 	void operator()(T& specimen);
 private:
@@ -43,7 +44,7 @@ private:
 };
 
 template<class... Mutations>
-inline chain_mutation<Mutations...>::chain_mutation(Mutations&&... mutations) noexcept(noexcept(Mutations(std::forward<Mutations>(mutations)...)))
+inline chain_mutation<Mutations...>::chain_mutation(Mutations&&... mutations) noexcept((std::is_nothrow_move_constructible_v<Mutations> && ...))
 	: mutations(std::forward<Mutations>(mutations)...) {}
 
 template<class... Mutations>
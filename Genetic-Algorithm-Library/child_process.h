@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_CHILD_PROCESS_H
+#define GENETIC_ALGORITHM_LIBRARY_CHILD_PROCESS_H
+
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <gsl/gsl_assert>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <algorithm>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/// A running program whose standard input and output are connected to pipes.
+/**
+\a command is the path of the program followed by its arguments; the
+program is looked up in \c PATH when the path has no directory. A program
+that cannot be started exits at once, so its output just ends. Writing
+to a program that has exited fails instead of raising \c SIGPIPE.
+Reading and writing may happen on different threads at the same time,
+and \c kill may be called from any thread. The destructor kills the
+program unless it has already exited, and waits for it.
+*/
+class child_process {
+public:
+	explicit child_process(const std::vector<std::string>& command);
+	child_process(const child_process&) = delete;
+	child_process& operator=(const child_process&) = delete;
+	~child_process();
+	bool write(const char* data, std::size_t size) noexcept;
+	std::size_t read(char* data, std::size_t size) noexcept;
+	void kill() noexcept;
+private:
+#ifdef _WIN32
+	static std::string quote(const std::string& argument);
+	HANDLE process = nullptr;
+	HANDLE input = nullptr;
+	HANDLE output = nullptr;
+#else
+	pid_t pid;
+	int input;
+	int output;
+#endif
+};
+
+#ifdef _WIN32
+
+inline child_process::child_process(const std::vector<std::string>& command) {
+	Expects(!command.empty());
+	std::string command_line;
+	for (const std::string& argument : command) {
+		if (!command_line.empty())
+			command_line += ' ';
+		command_line += quote(argument);
+	}
+	SECURITY_ATTRIBUTES inherited {sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
+	HANDLE child_input, child_output;
+	if (!CreatePipe(&child_input, &input, &inherited, 0))
+		throw std::system_error(GetLastError(), std::system_category(), "cannot create a pipe");
+	if (!CreatePipe(&output, &child_output, &inherited, 0)) {
+		const DWORD error = GetLastError();
+		CloseHandle(child_input);
+		CloseHandle(input);
+		throw std::system_error(error, std::system_category(), "cannot create a pipe");
+	}
+	SetHandleInformation(input, HANDLE_FLAG_INHERIT, 0);
+	SetHandleInformation(output, HANDLE_FLAG_INHERIT, 0);
+	STARTUPINFOA startup {};
+	startup.cb = sizeof(startup);
+	startup.dwFlags = STARTF_USESTDHANDLES;
+	startup.hStdInput = child_input;
+	startup.hStdOutput = child_output;
+	startup.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+	PROCESS_INFORMATION information {};
+	const BOOL started = CreateProcessA(nullptr, command_line.data(), nullptr, nullptr, TRUE, 0, nullptr, nullptr, &startup, &information);
+	const DWORD error = GetLastError();
+	CloseHandle(child_input);
+	CloseHandle(child_output);
+	if (!started) {
+		CloseHandle(input);
+		CloseHandle(output);
+		throw std::system_error(error, std::system_category(), "cannot start " + command.front());
+	}
+	CloseHandle(information.hThread);
+	process = information.hProcess;
+}
+
+inline child_process::~child_process() {
+	CloseHandle(input);
+	if (WaitForSingleObject(process, 0) != WAIT_OBJECT_0)
+		TerminateProcess(process, 1);
+	WaitForSingleObject(process, INFINITE);
+	CloseHandle(output);
+	CloseHandle(process);
+}
+
+inline bool child_process::write(const char* data, std::size_t size) noexcept {
+	while (size > 0) {
+		DWORD written;
+		if (!WriteFile(input, data, DWORD(std::min<std::size_t>(size, MAXDWORD)), &written, nullptr))
+			return false;
+		data += written;
+		size -= written;
+	}
+	return true;
+}
+
+inline std::size_t child_process::read(char* data, std::size_t size) noexcept {
+	DWORD count;
+	if (!ReadFile(output, data, DWORD(std::min<std::size_t>(size, MAXDWORD)), &count, nullptr))
+		return 0;
+	return count;
+}
+
+inline void child_process::kill() noexcept {
+	TerminateProcess(process, 1);
+}
+
+/// Quotes \a argument the way the C runtime splits command lines
+inline std::string child_process::quote(const std::string& argument) {
+	if (!argument.empty() && argument.find_first_of(" \t\"") == std::string::npos)
+		return argument;
+	std::string result = "\"";
+	std::size_t backslashes = 0;
+	for (const char c : argument) {
+		if (c == '\\') {
+			backslashes++;
+			continue;
+		}
+		result.append(c == '"' ? 2 * backslashes + 1 : backslashes, '\\');
+		result += c;
+		backslashes = 0;
+	}
+	result.append(2 * backslashes, '\\');
+	return result + '"';
+}
+
+#else
+
+inline child_process::child_process(const std::vector<std::string>& command) {
+	Expects(!command.empty());
+	std::vector<char*> arguments;
+	for (const std::string& argument : command) {
+		arguments.push_back(const_cast<char*>(argument.c_str()));
+	}
+	arguments.push_back(nullptr);
+	int to_child[2];
+	int from_child[2];
+	if (::pipe2(to_child, O_CLOEXEC) != 0)
+		throw std::system_error(errno, std::generic_category(), "cannot create a pipe");
+	if (::pipe2(from_child, O_CLOEXEC) != 0) {
+		const int error = errno;
+		::close(to_child[0]);
+		::close(to_child[1]);
+		throw std::system_error(error, std::generic_category(), "cannot create a pipe");
+	}
+	pid = ::fork();
+	if (pid == 0) {
+		::dup2(to_child[0], STDIN_FILENO);
+		::dup2(from_child[1], STDOUT_FILENO);
+		::execvp(arguments.front(), arguments.data());
+		::_exit(127);
+	}
+	const int error = errno;
+	::close(to_child[0]);
+	::close(from_child[1]);
+	input = to_child[1];
+	output = from_child[0];
+	if (pid < 0) {
+		::close(input);
+		::close(output);
+		throw std::system_error(error, std::generic_category(), "cannot start " + command.front());
+	}
+}
+
+inline child_process::~child_process() {
+	::close(input);
+	int status;
+	if (::waitpid(pid, &status, WNOHANG) == 0) {
+		::kill(pid, SIGKILL);
+		::waitpid(pid, &status, 0);
+	}
+	::close(output);
+}
+
+inline bool child_process::write(const char* data, std::size_t size) noexcept {
+	sigset_t broken_pipe;
+	sigset_t previous;
+	sigemptyset(&broken_pipe);
+	sigaddset(&broken_pipe, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &broken_pipe, &previous);
+	bool result = true;
+	while (size > 0) {
+		const ssize_t written = ::write(input, data, size);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0) {
+			if (errno == EPIPE) {
+				const timespec immediately {};
+				sigtimedwait(&broken_pipe, nullptr, &immediately);
+			}
+			result = false;
+			break;
+		}
+		data += written;
+		size -= written;
+	}
+	pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+	return result;
+}
+
+inline std::size_t child_process::read(char* data, std::size_t size) noexcept {
+	while (true) {
+		const ssize_t count = ::read(output, data, size);
+		if (count >= 0)
+			return count;
+		if (errno != EINTR)
+			return 0;
+	}
+}
+
+inline void child_process::kill() noexcept {
+	::kill(pid, SIGKILL);
+}
+
+#endif
+
+#endif
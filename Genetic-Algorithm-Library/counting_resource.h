@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_COUNTING_RESOURCE_H
+#define GENETIC_ALGORITHM_LIBRARY_COUNTING_RESOURCE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <gsl/gsl_assert>
+
+/// Memory resource counting the allocations it passes on to another resource.
+/**
+Installed as the default resource, or as \c context.memory_resource, it
+shows how often a run allocates, for example per stage with an
+\c allocation_logger. The counters are atomic, so the resource is as
+thread-safe as its upstream.
+*/
+class counting_resource : public std::pmr::memory_resource {
+public:
+	struct statistics_type {
+		std::size_t allocations;
+		std::size_t deallocations;
+		std::size_t bytes_allocated;
+		std::size_t bytes_deallocated;
+	};
+	explicit counting_resource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept;
+	statistics_type statistics() const noexcept;
+private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	std::pmr::memory_resource* upstream;
+	std::atomic<std::size_t> allocations {0};
+	std::atomic<std::size_t> deallocations {0};
+	std::atomic<std::size_t> bytes_allocated {0};
+	std::atomic<std::size_t> bytes_deallocated {0};
+};
+
+inline counting_resource::counting_resource(std::pmr::memory_resource* upstream) noexcept
+	: upstream(upstream) {
+	Expects(upstream != nullptr);
+}
+
+inline auto counting_resource::statistics() const noexcept -> statistics_type {
+	return {allocations.load(), deallocations.load(), bytes_allocated.load(), bytes_deallocated.load()};
+}
+
+inline void* counting_resource::do_allocate(std::size_t bytes, std::size_t alignment) {
+	void* const result = upstream->allocate(bytes, alignment);
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+	return result;
+}
+
+inline void counting_resource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+	upstream->deallocate(p, bytes, alignment);
+	deallocations.fetch_add(1, std::memory_order_relaxed);
+	bytes_deallocated.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+inline bool counting_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
+
+#endif
@@ -26,7 +26,6 @@
 #define GENETIC_ALGORITHM_LIBRARY_DEFAULT_LOGGER_H
 
 #include <ostream>
-#include <vector>
 
 template<class CharT, class Traits>
 class default_logger {
@@ -35,7 +34,7 @@ public:
 	explicit default_logger(ostream_type& out);
 	explicit default_logger(ostream_type&&) = delete;
 	template<class Algorithm>
-	void operator()(const Algorithm&, typename Algorithm::stage_type stage, const std::vector<typename Algorithm::evaluated_specimen_type>& specimens) const;
+	void operator()(const Algorithm&, typename Algorithm::stage_type stage, const typename Algorithm::population_type& specimens) const;
 private:
 	ostream_type& out;
 };
@@ -48,7 +47,7 @@ inline default_logger<CharT, Traits>::default_logger(ostream_type& out)
 
 template<class CharT, class Traits>
 template<class Algorithm>
-inline void default_logger<CharT, Traits>::operator()(const Algorithm&, typename Algorithm::stage_type stage, const std::vector<typename Algorithm::evaluated_specimen_type>& specimens) const {
+inline void default_logger<CharT, Traits>::operator()(const Algorithm&, typename Algorithm::stage_type stage, const typename Algorithm::population_type& specimens) const {
 	using stage_type = typename Algorithm::stage_type;
 	switch (stage) {
 		case stage_type::generated:
@@ -25,20 +25,27 @@
 #ifndef GENETIC_ALGORITHM_LIBRARY_ELITIST_SELECTION_H
 #define GENETIC_ALGORITHM_LIBRARY_ELITIST_SELECTION_H
 
-#include <algorithm>
 #include <cstddef>
 #include <functional>
+#include <memory_resource>
+#include <utility>
 #include <vector>
-#include <gsl/gsl_assert>
+#include "bounded_selection.h"
+#include "indexed_selection.h"
+#include "selection_holder.h"
 
 template<class Compare = std::less<>>
 class elitist_selection {
 public:
 	explicit elitist_selection(const Compare& comp = Compare()) noexcept(noexcept(Compare(comp)));
-	template<class Specimen>
-	void operator()(std::vector<Specimen>& specimens, std::size_t n) const;
+	template<class Specimen, class Allocator>
+	void operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n) const;
+	template<class Specimen, class Allocator>
+	void operator()(std::vector<Specimen, Allocator>& kept, std::size_t n, Specimen&& candidate) const;
 private:
 	Compare comparator;
+	mutable selection_holder<indexed_selection> scratch;
+	mutable selection_holder<bounded_selection> stream;
 };
 
 template<class Compare>
@@ -46,13 +53,24 @@ inline elitist_selection<Compare>::elitist_selection(const Compare& comp) noexce
 	: comparator(comp) {}
 
 template<class Compare>
-template<class Specimen>
-inline void elitist_selection<Compare>::operator()(std::vector<Specimen>& specimens, std::size_t n) const {
-	Expects(specimens.size() >= n);
-	std::nth_element(specimens.begin(), specimens.begin() + n, specimens.end(), [this](const Specimen& lhs, const Specimen& rhs) {
-		return comparator(rhs.rating(), lhs.rating());
+template<class Specimen, class Allocator>
+inline void elitist_selection<Compare>::operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n) const {
+	using rating_type = typename Specimen::rating_type;
+	scratch.get<rating_type>()(specimens, n, [](const Specimen& specimen) {
+		return specimen.rating();
+	}, [this](const rating_type& lhs, const rating_type& rhs) {
+		return comparator(rhs, lhs);
+	});
+}
+
+template<class Compare>
+template<class Specimen, class Allocator>
+inline void elitist_selection<Compare>::operator()(std::vector<Specimen, Allocator>& kept, std::size_t n, Specimen&& candidate) const {
+	using rating_type = typename Specimen::rating_type;
+	const rating_type rating = candidate.rating();
+	stream.get<rating_type>()(kept, n, std::move(candidate), rating, [this](const rating_type& lhs, const rating_type& rhs) {
+		return comparator(rhs, lhs);
 	});
-	specimens.resize(n);
 }
 
 #endif
@@ -41,12 +41,18 @@ public:
 	constexpr value_type& value() & noexcept;
 	constexpr const value_type& value() const& noexcept;
 	constexpr bool has_rating() const noexcept;
+	constexpr bool is_approximate() const noexcept;
+	constexpr bool is_bound() const noexcept;
 	constexpr rating_type rating() const;
 	template<class Function>
 	void evaluate(Function&& evaluator);
+	void estimate(const rating_type& prediction);
+	void bound(const rating_type& partial);
 private:
+	enum struct accuracy { exact, approximate, bound };
 	value_type specimen;
 	std::optional<rating_type> grade;
+	accuracy precision = accuracy::exact;
 };
 
 template<class Specimen, class Rating>
@@ -69,6 +75,16 @@ constexpr bool evaluated_specimen<Specimen, Rating>::has_rating() const noexcept
 	return grade.has_value();
 }
 
+template<class Specimen, class Rating>
+constexpr bool evaluated_specimen<Specimen, Rating>::is_approximate() const noexcept {
+	return precision == accuracy::approximate;
+}
+
+template<class Specimen, class Rating>
+constexpr bool evaluated_specimen<Specimen, Rating>::is_bound() const noexcept {
+	return precision == accuracy::bound;
+}
+
 template<class Specimen, class Rating>
 constexpr auto evaluated_specimen<Specimen, Rating>::rating() const -> rating_type {
 	return grade.value();
@@ -78,6 +94,23 @@ template<class Specimen, class Rating>
 template<class Function>
 inline void evaluated_specimen<Specimen, Rating>::evaluate(Function&& evaluator) {
 	grade.emplace(evaluator(std::as_const(specimen)));
+	precision = accuracy::exact;
+	Ensures(has_rating());
+}
+
+/// Rates the specimen with a predicted rating, to be replaced by \c evaluate if it matters
+template<class Specimen, class Rating>
+inline void evaluated_specimen<Specimen, Rating>::estimate(const rating_type& prediction) {
+	grade.emplace(prediction);
+	precision = accuracy::approximate;
+	Ensures(has_rating());
+}
+
+/// Rates the specimen with a partial rating, which its exact rating is known to be no better than
+template<class Specimen, class Rating>
+inline void evaluated_specimen<Specimen, Rating>::bound(const rating_type& partial) {
+	grade.emplace(partial);
+	precision = accuracy::bound;
 	Ensures(has_rating());
 }
 
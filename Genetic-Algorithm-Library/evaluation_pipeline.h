@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_EVALUATION_PIPELINE_H
+#define GENETIC_ALGORITHM_LIBRARY_EVALUATION_PIPELINE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include "trace_recorder.h"
+
+/// Worker threads evaluating batches of specimens handed to them by a single producer.
+/**
+Batches are tagged with the generation they belong to and come back
+through \c drain in the order they were finished, which need not be the
+order they were pushed in. An exception thrown while evaluating a batch
+is rethrown by the next call to \c drain. The evaluation of every batch
+and every wait in \c drain are recorded by the current \c trace_recorder.
+
+@tparam Specimen Type of the specimens, usually an \c evaluated_specimen
+@tparam Allocator Allocator of the batches
+*/
+template<class Specimen, class Allocator = std::allocator<Specimen>>
+class evaluation_pipeline {
+public:
+	using batch_type = std::vector<Specimen, Allocator>;
+	evaluation_pipeline(std::size_t threads, std::function<void(batch_type&)> evaluate);
+	evaluation_pipeline(const evaluation_pipeline&) = delete;
+	evaluation_pipeline& operator=(const evaluation_pipeline&) = delete;
+	~evaluation_pipeline();
+	void push(std::size_t generation, batch_type&& batch);
+	template<class Function>
+	void drain(Function f, bool wait);
+	std::size_t outstanding() const;
+private:
+	struct job_type {
+		std::size_t generation;
+		batch_type batch;
+	};
+	void work();
+	std::function<void(batch_type&)> evaluate;
+	mutable std::mutex mutex;
+	std::condition_variable work_available;
+	std::condition_variable result_available;
+	std::deque<job_type> pending;
+	std::deque<job_type> finished;
+	std::size_t in_flight = 0;
+	std::exception_ptr failure;
+	bool stopping = false;
+	std::vector<std::thread> workers;
+};
+
+template<class Specimen, class Allocator>
+inline evaluation_pipeline<Specimen, Allocator>::evaluation_pipeline(std::size_t threads, std::function<void(batch_type&)> evaluate)
+	: evaluate(std::move(evaluate)) {
+	Expects(threads > 0);
+	Expects(this->evaluate != nullptr);
+	workers.reserve(threads);
+	for (std::size_t i = 0; i < threads; i++) {
+		workers.emplace_back(&evaluation_pipeline::work, this);
+	}
+}
+
+template<class Specimen, class Allocator>
+inline evaluation_pipeline<Specimen, Allocator>::~evaluation_pipeline() {
+	{
+		std::lock_guard lock(mutex);
+		stopping = true;
+	}
+	work_available.notify_all();
+	for (auto&& worker : workers) {
+		worker.join();
+	}
+}
+
+template<class Specimen, class Allocator>
+inline void evaluation_pipeline<Specimen, Allocator>::push(std::size_t generation, batch_type&& batch) {
+	{
+		std::lock_guard lock(mutex);
+		pending.push_back({generation, std::move(batch)});
+		in_flight++;
+	}
+	work_available.notify_one();
+}
+
+/// Calls \a f with the generation and the batch of every finished batch
+/**
+With \a wait set, blocks until at least one batch is finished, unless
+none is left in flight.
+*/
+template<class Specimen, class Allocator>
+template<class Function>
+inline void evaluation_pipeline<Specimen, Allocator>::drain(Function f, bool wait) {
+	std::deque<job_type> ready;
+	{
+		std::unique_lock lock(mutex);
+		if (wait) {
+			trace_span span("wait for workers", "pipeline");
+			result_available.wait(lock, [this] {
+				return !finished.empty() || in_flight == 0 || failure != nullptr;
+			});
+		}
+		if (failure != nullptr)
+			std::rethrow_exception(std::exchange(failure, nullptr));
+		ready.swap(finished);
+		in_flight -= ready.size();
+	}
+	for (auto&& job : ready) {
+		f(job.generation, std::move(job.batch));
+	}
+}
+
+template<class Specimen, class Allocator>
+inline std::size_t evaluation_pipeline<Specimen, Allocator>::outstanding() const {
+	std::lock_guard lock(mutex);
+	return in_flight;
+}
+
+template<class Specimen, class Allocator>
+inline void evaluation_pipeline<Specimen, Allocator>::work() {
+	if (trace_recorder* recorder = trace_recorder::current())
+		recorder->name_thread("evaluation worker");
+	while (true) {
+		std::unique_lock lock(mutex);
+		work_available.wait(lock, [this] {
+			return stopping || !pending.empty();
+		});
+		if (pending.empty())
+			return;
+		job_type job = std::move(pending.front());
+		pending.pop_front();
+		lock.unlock();
+		try {
+			{
+				trace_span span("evaluate batch", "worker");
+				evaluate(job.batch);
+			}
+			lock.lock();
+			finished.push_back(std::move(job));
+		} catch (...) {
+			lock.lock();
+			failure = std::current_exception();
+			in_flight--;
+		}
+		lock.unlock();
+		result_available.notify_one();
+	}
+}
+
+#endif
@@ -26,31 +26,74 @@
 #define GENETIC_ALGORITHM_LIBRARY_GENETIC_ALGORITHM_H
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <type_traits>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <gsl/gsl_assert>
 #include "evaluated_specimen.h"
+#include "evaluation_pipeline.h"
 #include "repeat.h"
 
+template<class Observer, class Algorithm, class = void>
+struct observes_phases : std::false_type {};
+
+template<class Observer, class Algorithm>
+struct observes_phases<Observer, Algorithm, std::void_t<
+	decltype(std::declval<Observer&>().enter(std::declval<const Algorithm&>(), std::declval<typename Algorithm::phase_type>())),
+	decltype(std::declval<Observer&>().leave(std::declval<const Algorithm&>(), std::declval<typename Algorithm::phase_type>()))>> : std::true_type {};
+
+template<class Observer, class Algorithm, class = void>
+struct observes_timeouts : std::false_type {};
+
+template<class Observer, class Algorithm>
+struct observes_timeouts<Observer, Algorithm, std::void_t<
+	decltype(std::declval<Observer&>().timeouts(std::declval<const Algorithm&>(), std::declval<std::size_t>()))>> : std::true_type {};
+
 template<class Specimen, class Rating>
 class genetic_algorithm {
 public:
 	using specimen_type = Specimen;
 	using rating_type = Rating;
 	using evaluated_specimen_type = evaluated_specimen<Specimen, Rating>;
+	using population_type = std::pmr::vector<evaluated_specimen_type>;
 	struct context_type;
 	enum struct stage_type { generated, selected, bred };
+	enum struct phase_type { generate, evaluate, select, breed };
+	static constexpr std::size_t streaming_chunk_size = 256;
 	explicit genetic_algorithm(const context_type& context);
 	explicit genetic_algorithm(context_type&& context);
 	template<class... Functions>
 	evaluated_specimen_type operator()(Functions&&... observers) const;
 private:
+	std::pmr::memory_resource* resource() const noexcept;
+	using timeout_counter = std::atomic<std::size_t>;
+	template<class... Functions>
+	void communicate_stage(stage_type stage, const population_type& specimens, const timeout_counter& timed_out, Functions&&... observers) const;
+	template<class... Functions>
+	void enter_phase(phase_type phase, Functions&&... observers) const;
+	template<class... Functions>
+	void leave_phase(phase_type phase, Functions&&... observers) const;
+	bool finished(const population_type& specimens, const std::optional<evaluated_specimen_type>& best) const;
+	bool has_deadline() const noexcept;
+	rating_type evaluate_within_deadline(const specimen_type& specimen, timeout_counter& timed_out) const;
+	void evaluate(population_type& specimens, timeout_counter& timed_out) const;
+	void evaluate_offspring(population_type& specimens, timeout_counter& timed_out, const std::optional<rating_type>& cutoff = std::nullopt) const;
+	void deduplicate(population_type& specimens, std::pmr::unordered_set<std::uint64_t>& fingerprints) const;
+	template<class... Functions>
+	bool replenish(population_type& specimens, timeout_counter& timed_out, Functions&&... observers) const;
+	population_type breed(const population_type& specimens) const;
+	template<class... Functions>
+	population_type breed_streaming(const population_type& specimens, std::pmr::unordered_set<std::uint64_t>& fingerprints, std::optional<evaluated_specimen_type>& best, timeout_counter& timed_out, Functions&&... observers) const;
 	template<class... Functions>
-	void communicate_stage(stage_type stage, const std::vector<evaluated_specimen_type>& specimens, Functions&&... observers) const;
-	void evaluate(std::vector<evaluated_specimen_type>& specimens) const;
-	std::vector<evaluated_specimen_type> breed(const std::vector<evaluated_specimen_type>& specimens) const;
+	population_type breed_pipelined(population_type specimens, std::pmr::unordered_set<std::uint64_t>& fingerprints, std::optional<evaluated_specimen_type>& best, timeout_counter& timed_out, Functions&&... observers) const;
 	context_type context;
 };
 
@@ -61,9 +104,24 @@ struct genetic_algorithm<Specimen, Rating>::context_type {
 	std::size_t max_iterations = 0;
 	std::function<specimen_type()> generator;
 	std::function<rating_type(const specimen_type&)> evaluator;
-	std::function<void(std::vector<evaluated_specimen_type>&, std::size_t)> selector;
+	std::function<std::size_t(population_type&)> batch_evaluator;
+	std::function<void(population_type&, std::size_t)> selector;
 	std::function<specimen_type(const specimen_type&, const specimen_type&)> breeder;
+	std::function<void(population_type&)> mutator;
+	std::function<void(population_type&, std::size_t, evaluated_specimen_type&&)> streaming_selector;
 	std::function<bool(rating_type, rating_type)> comparator;
+	std::function<bool(const rating_type&)> terminator;
+	std::function<std::uint64_t(const specimen_type&)> fingerprint;
+	bool regenerate_duplicates = false;
+	std::function<void(population_type&, const std::function<rating_type(const specimen_type&)>&)> screener;
+	std::function<rating_type(const specimen_type&, const rating_type&)> bounded_evaluator;
+	bool threshold_streaming = false;
+	std::function<std::optional<rating_type>(const specimen_type&, std::chrono::steady_clock::time_point)> deadline_evaluator;
+	std::chrono::steady_clock::duration evaluation_timeout = std::chrono::steady_clock::duration::zero();
+	std::optional<rating_type> timeout_rating;
+	std::size_t evaluation_threads = 0;
+	std::size_t max_staleness = 1;
+	std::pmr::memory_resource* memory_resource = nullptr;
 };
 
 template<class Context>
@@ -86,47 +144,300 @@ template<class Specimen, class Rating>
 inline genetic_algorithm<Specimen, Rating>::genetic_algorithm(context_type&& context)
 	: context(std::move(context)) {}
 
+/// Resource of the population arrays and of the bookkeeping of a run, \c context.memory_resource or else the ordinary heap
+/**
+It is not the default resource, so that installing a resource such as a
+\c budgeted_resource as the default only moves the specimens that
+allocate from it, and never the arrays holding their ratings.
+*/
+template<class Specimen, class Rating>
+inline std::pmr::memory_resource* genetic_algorithm<Specimen, Rating>::resource() const noexcept {
+	return context.memory_resource != nullptr ? context.memory_resource : std::pmr::new_delete_resource();
+}
+
 template<class Specimen, class Rating>
 template<class... Functions>
 inline auto genetic_algorithm<Specimen, Rating>::operator()(Functions&&... observers) const -> evaluated_specimen_type {
 	Expects(valid(context));
-	std::vector<evaluated_specimen_type> specimens(context.initial_population_size);
+	Expects(!has_deadline() || context.timeout_rating.has_value());
+	Expects(!has_deadline() || context.batch_evaluator == nullptr);
+	Expects(!context.threshold_streaming || context.streaming_selector != nullptr);
+	timeout_counter timed_out {0};
+	enter_phase(phase_type::generate, std::forward<Functions>(observers)...);
+	population_type specimens(context.initial_population_size, typename population_type::allocator_type(resource()));
 	for (auto&& specimen : specimens) {
 		specimen.value() = context.generator();
 	}
-	evaluate(specimens);
-	communicate_stage(stage_type::generated, specimens, std::forward<Functions>(observers)...);
-	repeat(context.max_iterations, [&] {
-		context.selector(specimens, context.breeding_population_size);
-		communicate_stage(stage_type::selected, specimens, std::forward<Functions>(observers)...);
-		specimens = breed(specimens);
-		evaluate(specimens);
-		communicate_stage(stage_type::bred, specimens, std::forward<Functions>(observers)...);
-	});
-	return std::move(*std::max_element(specimens.begin(), specimens.end(), [this](const evaluated_specimen_type& lhs, const evaluated_specimen_type& rhs) {
+	leave_phase(phase_type::generate, std::forward<Functions>(observers)...);
+	enter_phase(phase_type::evaluate, std::forward<Functions>(observers)...);
+	evaluate(specimens, timed_out);
+	leave_phase(phase_type::evaluate, std::forward<Functions>(observers)...);
+	communicate_stage(stage_type::generated, specimens, timed_out, std::forward<Functions>(observers)...);
+	std::optional<evaluated_specimen_type> best;
+	std::pmr::unsynchronized_pool_resource fingerprint_pool(resource());
+	std::pmr::unordered_set<std::uint64_t> fingerprints(&fingerprint_pool);
+	if (context.evaluation_threads > 0) {
+		Expects(context.streaming_selector != nullptr);
+		specimens = breed_pipelined(std::move(specimens), fingerprints, best, timed_out, std::forward<Functions>(observers)...);
+	} else {
+		bool streamed = false;
+		repeat_until(context.max_iterations, [&] {
+			if (replenish(specimens, timed_out, std::forward<Functions>(observers)...) || !streamed) {
+				enter_phase(phase_type::select, std::forward<Functions>(observers)...);
+				context.selector(specimens, context.breeding_population_size);
+				leave_phase(phase_type::select, std::forward<Functions>(observers)...);
+			}
+			communicate_stage(stage_type::selected, specimens, timed_out, std::forward<Functions>(observers)...);
+			if (context.streaming_selector != nullptr) {
+				specimens = breed_streaming(specimens, fingerprints, best, timed_out, std::forward<Functions>(observers)...);
+				streamed = true;
+			} else {
+				enter_phase(phase_type::breed, std::forward<Functions>(observers)...);
+				specimens = breed(specimens);
+				if (context.mutator != nullptr)
+					context.mutator(specimens);
+				fingerprints.clear();
+				deduplicate(specimens, fingerprints);
+				leave_phase(phase_type::breed, std::forward<Functions>(observers)...);
+				enter_phase(phase_type::evaluate, std::forward<Functions>(observers)...);
+				evaluate_offspring(specimens, timed_out);
+				leave_phase(phase_type::evaluate, std::forward<Functions>(observers)...);
+			}
+			communicate_stage(stage_type::bred, specimens, timed_out, std::forward<Functions>(observers)...);
+			return finished(specimens, best);
+		});
+	}
+	const auto worse = [this](const evaluated_specimen_type& lhs, const evaluated_specimen_type& rhs) {
 		return context.comparator(lhs.rating(), rhs.rating());
-	}));
+	};
+	if (best.has_value())
+		specimens.push_back(std::move(*best));
+	while (true) {
+		const auto result = std::max_element(specimens.begin(), specimens.end(), worse);
+		if (!result->is_approximate())
+			return std::move(*result);
+		result->evaluate(context.evaluator);
+	}
 }
 
 template<class Specimen, class Rating>
 template<class... Functions>
-inline void genetic_algorithm<Specimen, Rating>::communicate_stage(stage_type stage, const std::vector<evaluated_specimen_type>& specimens, Functions&&... observers) const {
+inline void genetic_algorithm<Specimen, Rating>::communicate_stage(stage_type stage, const population_type& specimens, const timeout_counter& timed_out, Functions&&... observers) const {
 	(void)stage;
 	(void)specimens;
+	const std::size_t timeouts = timed_out.load(std::memory_order_relaxed);
+	const auto report = [&](auto& observer) {
+		if constexpr (observes_timeouts<std::remove_const_t<std::remove_reference_t<decltype(observer)>>, genetic_algorithm>::value)
+			observer.timeouts(*this, timeouts);
+	};
+	(void)report;
+	(report(observers), ...);
 	((void)observers(*this, stage, specimens), ...);
 }
 
+/// Tells the observers that have an \c enter member that \a phase starts
+/**
+Phases never nest: every \c enter is followed by a \c leave of the same
+phase before the next one is entered. Observers without \c enter and
+\c leave members are only told about stages.
+*/
+template<class Specimen, class Rating>
+template<class... Functions>
+inline void genetic_algorithm<Specimen, Rating>::enter_phase(phase_type phase, Functions&&... observers) const {
+	(void)phase;
+	const auto enter = [&](auto& observer) {
+		if constexpr (observes_phases<std::remove_const_t<std::remove_reference_t<decltype(observer)>>, genetic_algorithm>::value)
+			observer.enter(*this, phase);
+	};
+	(void)enter;
+	(enter(observers), ...);
+}
+
+template<class Specimen, class Rating>
+template<class... Functions>
+inline void genetic_algorithm<Specimen, Rating>::leave_phase(phase_type phase, Functions&&... observers) const {
+	(void)phase;
+	const auto leave = [&](auto& observer) {
+		if constexpr (observes_phases<std::remove_const_t<std::remove_reference_t<decltype(observer)>>, genetic_algorithm>::value)
+			observer.leave(*this, phase);
+	};
+	(void)leave;
+	(leave(observers), ...);
+}
+
+/// Tells whether the terminator, if any, ends the run given the best exact rating of a generation
+/**
+The best rating is that of the specimens kept for the next generation,
+or of the best child set aside in \a best. Only exact ratings count, not
+predictions of the screener nor bounds of the bounded evaluator, since
+the terminator may take the rating as the length of a tour that exists.
+The terminator is asked after the observers have seen the generation.
+*/
+template<class Specimen, class Rating>
+inline bool genetic_algorithm<Specimen, Rating>::finished(const population_type& specimens, const std::optional<evaluated_specimen_type>& best) const {
+	if (context.terminator == nullptr)
+		return false;
+	const evaluated_specimen_type* result = nullptr;
+	const auto consider = [&](const evaluated_specimen_type& specimen) {
+		if (specimen.is_approximate() || specimen.is_bound())
+			return;
+		if (result == nullptr || context.comparator(result->rating(), specimen.rating()))
+			result = &specimen;
+	};
+	for (const auto& specimen : specimens) {
+		consider(specimen);
+	}
+	if (best.has_value())
+		consider(*best);
+	return result != nullptr && context.terminator(result->rating());
+}
+
+/// Tells whether evaluations are given a deadline
 template<class Specimen, class Rating>
-inline void genetic_algorithm<Specimen, Rating>::evaluate(std::vector<evaluated_specimen_type>& specimens) const {
+inline bool genetic_algorithm<Specimen, Rating>::has_deadline() const noexcept {
+	return context.deadline_evaluator != nullptr && context.evaluation_timeout > std::chrono::steady_clock::duration::zero();
+}
+
+/// Rates \a specimen with the deadline evaluator, or \c timeout_rating if it gives up
+/**
+The deadline evaluator is given the point in time by which it should be
+done and returns no rating if it gives up. Such specimens are rated
+\c timeout_rating instead, which has to be bad enough for them to be
+dropped by selection, and are counted in \a timed_out. Evaluators cannot
+be interrupted, so one that ignores its deadline still holds up the
+generation.
+*/
+template<class Specimen, class Rating>
+inline auto genetic_algorithm<Specimen, Rating>::evaluate_within_deadline(const specimen_type& specimen, timeout_counter& timed_out) const -> rating_type {
+	const std::optional<rating_type> rating = context.deadline_evaluator(specimen, std::chrono::steady_clock::now() + context.evaluation_timeout);
+	if (rating.has_value())
+		return *rating;
+	timed_out.fetch_add(1, std::memory_order_relaxed);
+	return *context.timeout_rating;
+}
+
+/// Rates the specimens exactly, with the batch evaluator if there is one, or each within \c evaluation_timeout if a deadline evaluator is set
+/**
+The batch evaluator rates all the specimens at once, which lets it spread
+them over other threads or processes. It cannot be combined with a
+deadline evaluator and enforces timeouts of its own, if any, as
+\c process_evaluator does, returning how many specimens it rated as
+timed out. Evaluations that miss their deadline are counted in
+\a timed_out either way, which observers with a \c timeouts member are
+told about with every stage.
+*/
+template<class Specimen, class Rating>
+inline void genetic_algorithm<Specimen, Rating>::evaluate(population_type& specimens, timeout_counter& timed_out) const {
+	if (context.batch_evaluator != nullptr) {
+		timed_out.fetch_add(context.batch_evaluator(specimens), std::memory_order_relaxed);
+		return;
+	}
+	if (!has_deadline()) {
+		for (auto&& specimen : specimens) {
+			specimen.evaluate(context.evaluator);
+		}
+		return;
+	}
 	for (auto&& specimen : specimens) {
-		specimen.evaluate(context.evaluator);
+		specimen.evaluate([&](const specimen_type& value) {
+			return evaluate_within_deadline(value, timed_out);
+		});
+	}
+}
+
+/// Rates new offspring, through the screener if there is one
+/**
+The screener may give some of the specimens a predicted rating only. Those
+keep competing in selection, but the final result is always rated exactly.
+
+Otherwise, given a \a cutoff, the bounded evaluator is used if there is
+one. It may stop as soon as it can tell that a specimen is worse than the
+cutoff and return the partial rating, which then marks the specimen as a
+bound. The evaluator must be monotone in the sense of the comparator:
+the partial rating can only get worse as more of the specimen is rated,
+so once it is worse than the cutoff, the exact rating is too. For
+ratings to be minimized, such as the length of a path, this means that
+the parts rated are never negative. Rated up to the end, the specimen
+gets its exact rating.
+
+With a deadline evaluator, the screener rates specimens exactly within
+the deadline too, and the bounded evaluator, which cannot be given a
+deadline, is not used.
+*/
+template<class Specimen, class Rating>
+inline void genetic_algorithm<Specimen, Rating>::evaluate_offspring(population_type& specimens, timeout_counter& timed_out, const std::optional<rating_type>& cutoff) const {
+	if (context.screener != nullptr && has_deadline()) {
+		context.screener(specimens, [&](const specimen_type& specimen) {
+			return evaluate_within_deadline(specimen, timed_out);
+		});
+	} else if (context.screener != nullptr) {
+		context.screener(specimens, context.evaluator);
+	} else if (cutoff.has_value() && context.bounded_evaluator != nullptr && !has_deadline()) {
+		for (auto&& specimen : specimens) {
+			const rating_type rating = context.bounded_evaluator(specimen.value(), *cutoff);
+			if (context.comparator(rating, *cutoff))
+				specimen.bound(rating);
+			else
+				specimen.evaluate([&](const specimen_type&) { return rating; });
+		}
+	} else {
+		evaluate(specimens, timed_out);
+	}
+}
+
+/// Drops or regenerates the specimens whose fingerprint is already in \a fingerprints.
+/**
+Does nothing unless a fingerprint function is set. Two specimens are
+treated as equal when their fingerprints are, so the fingerprint should
+be a 64-bit hash of a canonical form of the specimen. A duplicate is
+replaced by a newly generated specimen at most once. Dropped duplicates
+may leave fewer specimens than the selector needs, which \c replenish
+makes up for before the next selection.
+*/
+template<class Specimen, class Rating>
+inline void genetic_algorithm<Specimen, Rating>::deduplicate(population_type& specimens, std::pmr::unordered_set<std::uint64_t>& fingerprints) const {
+	if (context.fingerprint == nullptr)
+		return;
+	if (context.regenerate_duplicates) {
+		for (auto&& specimen : specimens) {
+			if (!fingerprints.insert(context.fingerprint(specimen.value())).second) {
+				specimen.value() = context.generator();
+				fingerprints.insert(context.fingerprint(specimen.value()));
+			}
+		}
+	} else {
+		specimens.erase(std::remove_if(specimens.begin(), specimens.end(), [&](const evaluated_specimen_type& specimen) {
+			return !fingerprints.insert(context.fingerprint(specimen.value())).second;
+		}), specimens.end());
+	}
+}
+
+/// Tops \a specimens up with newly generated and evaluated ones until there are enough to select \c breeding_population_size from
+/**
+@return Whether any specimens were added
+*/
+template<class Specimen, class Rating>
+template<class... Functions>
+inline bool genetic_algorithm<Specimen, Rating>::replenish(population_type& specimens, timeout_counter& timed_out, Functions&&... observers) const {
+	if (specimens.size() >= context.breeding_population_size)
+		return false;
+	enter_phase(phase_type::generate, std::forward<Functions>(observers)...);
+	population_type fresh(context.breeding_population_size - specimens.size(), typename population_type::allocator_type(resource()));
+	for (auto&& specimen : fresh) {
+		specimen.value() = context.generator();
 	}
+	leave_phase(phase_type::generate, std::forward<Functions>(observers)...);
+	enter_phase(phase_type::evaluate, std::forward<Functions>(observers)...);
+	evaluate(fresh, timed_out);
+	leave_phase(phase_type::evaluate, std::forward<Functions>(observers)...);
+	std::move(fresh.begin(), fresh.end(), std::back_inserter(specimens));
+	return true;
 }
 
 template<class Specimen, class Rating>
-inline auto genetic_algorithm<Specimen, Rating>::breed(const std::vector<evaluated_specimen_type>& specimens) const -> std::vector<evaluated_specimen_type> {
+inline auto genetic_algorithm<Specimen, Rating>::breed(const population_type& specimens) const -> population_type {
 	const std::size_t specimen_count = specimens.size();
-	std::vector<evaluated_specimen_type> result;
+	population_type result(resource());
 	const std::size_t reserve = specimen_count * (specimen_count - 1) / 2;
 	result.reserve(reserve);
 	for (auto it = specimens.begin(); it != specimens.end(); ++it) {
@@ -139,4 +450,169 @@ inline auto genetic_algorithm<Specimen, Rating>::breed(const std::vector<evaluat
 	return result;
 }
 
+/// Breeds, mutates and evaluates the offspring in small chunks, passing every child to the streaming selector.
+/**
+Only \c breeding_population_size children are kept at a time instead of
+the whole generation. With \c threshold_streaming set, the streaming
+selector must be one that never keeps a child worse than all those it
+already keeps, such as \c elitist_selection. Once it keeps a full
+breeding population, the worst rating among them is then a cutoff no
+kept child can fall below, and the children are rated with the bounded
+evaluator against it. Bound children are never offered to the selector. The best child is kept aside in \a best, since a
+randomized streaming selector may drop it. The children kept have
+already been selected, so the next generation is bred from them without
+calling the selector again, unless \c replenish has to top them up.
+*/
+template<class Specimen, class Rating>
+template<class... Functions>
+inline auto genetic_algorithm<Specimen, Rating>::breed_streaming(const population_type& specimens, std::pmr::unordered_set<std::uint64_t>& fingerprints, std::optional<evaluated_specimen_type>& best, timeout_counter& timed_out, Functions&&... observers) const -> population_type {
+	enter_phase(phase_type::breed, std::forward<Functions>(observers)...);
+	population_type result(resource());
+	result.reserve(context.breeding_population_size);
+	population_type chunk(resource());
+	chunk.reserve(streaming_chunk_size);
+	best.reset();
+	fingerprints.clear();
+	const auto worse = [this](const evaluated_specimen_type& lhs, const evaluated_specimen_type& rhs) {
+		return context.comparator(lhs.rating(), rhs.rating());
+	};
+	const auto flush = [&] {
+		if (context.mutator != nullptr)
+			context.mutator(chunk);
+		deduplicate(chunk, fingerprints);
+		std::optional<rating_type> cutoff;
+		if (context.threshold_streaming && result.size() == context.breeding_population_size)
+			cutoff = std::min_element(result.begin(), result.end(), worse)->rating();
+		leave_phase(phase_type::breed, observers...);
+		enter_phase(phase_type::evaluate, observers...);
+		evaluate_offspring(chunk, timed_out, cutoff);
+		leave_phase(phase_type::evaluate, observers...);
+		enter_phase(phase_type::select, observers...);
+		for (auto&& child : chunk) {
+			if (child.is_bound())
+				continue;
+			if (!best.has_value() || context.comparator(best->rating(), child.rating()))
+				best = child;
+			context.streaming_selector(result, context.breeding_population_size, std::move(child));
+		}
+		Ensures(!cutoff.has_value() || !context.comparator(std::min_element(result.begin(), result.end(), worse)->rating(), *cutoff));
+		leave_phase(phase_type::select, observers...);
+		enter_phase(phase_type::breed, observers...);
+		chunk.clear();
+	};
+	for (auto it = specimens.begin(); it != specimens.end(); ++it) {
+		const specimen_type& father = it->value();
+		std::for_each(std::next(it), specimens.end(), [&](const evaluated_specimen_type& mother) {
+			chunk.emplace_back(evaluated_specimen_type {context.breeder(father, mother.value())});
+			if (chunk.size() == streaming_chunk_size)
+				flush();
+		});
+	}
+	flush();
+	leave_phase(phase_type::breed, std::forward<Functions>(observers)...);
+	Ensures(result.size() <= context.breeding_population_size);
+	return result;
+}
+
+/// Overlaps the breeding of each generation with the evaluation of the previous ones.
+/**
+The children are evaluated in batches by \c evaluation_threads worker
+threads, so the evaluator has to be safe to call concurrently, while this
+thread keeps breeding and feeding the evaluated children to the streaming
+selector. A generation starts as soon as enough children of the previous
+one have been evaluated to fill the breeding population and no generation
+more than \c max_staleness generations back has children left to
+evaluate; children arriving after their generation was selected from
+compete in the next selection instead. Every generation is still reported
+to the observers as selected and then bred, in order. The screener and
+the bounded evaluator are not used in this mode. The evaluate phase
+reported to the observers covers only the time this thread spends
+waiting for the workers, and the children evaluated meanwhile are passed
+to the streaming selector within the breed phase. As with
+\c breed_streaming, the selector is only called on the generated
+population and on pools that \c replenish had to top up.
+*/
+template<class Specimen, class Rating>
+template<class... Functions>
+inline auto genetic_algorithm<Specimen, Rating>::breed_pipelined(population_type specimens, std::pmr::unordered_set<std::uint64_t>& fingerprints, std::optional<evaluated_specimen_type>& best, timeout_counter& timed_out, Functions&&... observers) const -> population_type {
+	const std::size_t population_size = context.breeding_population_size;
+	evaluation_pipeline<evaluated_specimen_type, typename population_type::allocator_type> pipeline(context.evaluation_threads, [this, &timed_out](population_type& batch) {
+		evaluate(batch, timed_out);
+	});
+	std::pmr::vector<std::size_t> unfinished(resource());
+	std::size_t settled = 0;
+	population_type pool(resource());
+	const auto offer = [&](std::size_t generation, population_type&& batch) {
+		unfinished[generation]--;
+		for (auto&& child : batch) {
+			if (!best.has_value() || context.comparator(best->rating(), child.rating()))
+				best = child;
+			context.streaming_selector(pool, population_size, std::move(child));
+		}
+	};
+	const auto ready = [&](std::size_t generation) {
+		while (settled + context.max_staleness < generation && unfinished[settled] == 0) {
+			settled++;
+		}
+		return settled + context.max_staleness >= generation && (pool.size() >= population_size || pipeline.outstanding() == 0);
+	};
+	population_type chunk(resource());
+	const auto flush = [&](std::size_t generation) {
+		if (chunk.empty())
+			return;
+		if (context.mutator != nullptr)
+			context.mutator(chunk);
+		deduplicate(chunk, fingerprints);
+		unfinished[generation]++;
+		pipeline.push(generation, std::move(chunk));
+		chunk = {};
+		chunk.reserve(streaming_chunk_size);
+		pipeline.drain(offer, false);
+	};
+	for (std::size_t generation = 0; generation < context.max_iterations; generation++) {
+		if (generation > 0) {
+			enter_phase(phase_type::evaluate, std::forward<Functions>(observers)...);
+			while (!ready(generation)) {
+				pipeline.drain(offer, true);
+			}
+			leave_phase(phase_type::evaluate, std::forward<Functions>(observers)...);
+			communicate_stage(stage_type::bred, pool, timed_out, std::forward<Functions>(observers)...);
+			specimens = std::move(pool);
+			pool.clear();
+			if (finished(specimens, best))
+				return specimens;
+		}
+		if (replenish(specimens, timed_out, std::forward<Functions>(observers)...) || generation == 0) {
+			enter_phase(phase_type::select, std::forward<Functions>(observers)...);
+			context.selector(specimens, population_size);
+			leave_phase(phase_type::select, std::forward<Functions>(observers)...);
+		}
+		communicate_stage(stage_type::selected, specimens, timed_out, std::forward<Functions>(observers)...);
+		enter_phase(phase_type::breed, std::forward<Functions>(observers)...);
+		best.reset();
+		fingerprints.clear();
+		unfinished.push_back(0);
+		chunk.reserve(streaming_chunk_size);
+		for (auto it = specimens.begin(); it != specimens.end(); ++it) {
+			const specimen_type& father = it->value();
+			std::for_each(std::next(it), specimens.end(), [&](const evaluated_specimen_type& mother) {
+				chunk.emplace_back(evaluated_specimen_type {context.breeder(father, mother.value())});
+				if (chunk.size() == streaming_chunk_size)
+					flush(generation);
+			});
+		}
+		flush(generation);
+		leave_phase(phase_type::breed, std::forward<Functions>(observers)...);
+	}
+	if (context.max_iterations == 0)
+		return specimens;
+	enter_phase(phase_type::evaluate, std::forward<Functions>(observers)...);
+	while (pipeline.outstanding() > 0) {
+		pipeline.drain(offer, true);
+	}
+	leave_phase(phase_type::evaluate, std::forward<Functions>(observers)...);
+	communicate_stage(stage_type::bred, pool, timed_out, std::forward<Functions>(observers)...);
+	return pool;
+}
+
 #endif
@@ -25,16 +25,49 @@
 #ifndef GENETIC_ALGORITHM_LIBRARY_GENETICS_H
 #define GENETIC_ALGORITHM_LIBRARY_GENETICS_H
 
+#include "allocation_logger.h"
+#include "batch_mutation.h"
+#include "bounded_selection.h"
+#include "budgeted_resource.h"
+#include "bulk_distribution.h"
+#include "bulk_random.h"
 #include "chain_mutation.h"
+#include "child_process.h"
+#include "counting_resource.h"
 #include "default_logger.h"
 #include "elitist_selection.h"
 #include "evaluated_specimen.h"
+#include "evaluation_pipeline.h"
 #include "genetic_algorithm.h"
 #include "identity.h"
+#include "indexed_selection.h"
+#include "linear_rank_selection.h"
+#include "linear_surrogate.h"
+#include "mapped_file.h"
+#include "mapped_file_resource.h"
 #include "mutate_with_probability.h"
 #include "mutating_breeder.h"
+#include "nearest_neighbor_surrogate.h"
+#include "parallel_generator.h"
+#include "performance_counter_logger.h"
+#include "performance_counters.h"
+#include "persistent_evaluator.h"
+#include "persistent_rating_table.h"
+#include "process_evaluator.h"
+#include "random_stream_family.h"
 #include "repeat.h"
+#include "replicate_selected.h"
 #include "roulette_wheel_selection.h"
+#include "selection_holder.h"
+#include "stochastic_universal_sampling.h"
+#include "surrogate_screening.h"
+#include "telemetry_logger.h"
+#include "telemetry_server.h"
 #include "thread_safe_random.h"
+#include "tournament_selection.h"
+#include "trace_logger.h"
+#include "trace_recorder.h"
+#include "traced_function.h"
+#include "xoshiro256_star_star.h"
 
 #endif
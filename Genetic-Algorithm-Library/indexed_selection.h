@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_INDEXED_SELECTION_H
+#define GENETIC_ALGORITHM_LIBRARY_INDEXED_SELECTION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+
+/// Selects specimens by sorting a packed array of (key, index) pairs.
+/**
+Only the keys are reordered while looking for the \a n best ones, after
+which every selected specimen is moved to the front of the population at
+most once. The key array is kept between calls, so selection does not
+allocate once it has seen the largest population. Populations of at least
+\c parallel_threshold specimens are partitioned in parallel.
+
+@tparam Key Type of the sort keys
+*/
+template<class Key>
+class indexed_selection {
+public:
+	using key_type = Key;
+	explicit indexed_selection(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+	static constexpr std::size_t parallel_threshold = 1 << 16;
+	template<class Specimen, class Allocator, class Function, class Compare>
+	void operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n, Function key, Compare comp);
+private:
+	struct entry {
+		key_type key;
+		std::size_t index;
+	};
+	std::pmr::vector<entry> entries;
+	std::pmr::vector<bool> chosen;
+};
+
+template<class Key>
+inline indexed_selection<Key>::indexed_selection(std::pmr::memory_resource* resource)
+	: entries(resource), chosen(resource) {}
+
+template<class Key>
+template<class Specimen, class Allocator, class Function, class Compare>
+inline void indexed_selection<Key>::operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n, Function key, Compare comp) {
+	Expects(specimens.size() >= n);
+	const std::size_t size = specimens.size();
+	entries.clear();
+	for (std::size_t i = 0; i < size; i++) {
+		entries.push_back({key(specimens[i]), i});
+	}
+	const auto precedes = [&](const entry& lhs, const entry& rhs) {
+		return comp(lhs.key, rhs.key);
+	};
+	if (size >= parallel_threshold)
+		std::nth_element(std::execution::par, entries.begin(), entries.begin() + n, entries.end(), precedes);
+	else
+		std::nth_element(entries.begin(), entries.begin() + n, entries.end(), precedes);
+	chosen.assign(n, false);
+	for (std::size_t i = 0; i < n; i++) {
+		const std::size_t index = entries[i].index;
+		if (index < n)
+			chosen[index] = true;
+	}
+	std::size_t hole = 0;
+	for (std::size_t i = 0; i < n; i++) {
+		const std::size_t index = entries[i].index;
+		if (index >= n) {
+			while (chosen[hole]) {
+				hole++;
+			}
+			std::swap(specimens[hole++], specimens[index]);
+		}
+	}
+	specimens.resize(n);
+}
+
+#endif
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_LINEAR_RANK_SELECTION_H
+#define GENETIC_ALGORITHM_LIBRARY_LINEAR_RANK_SELECTION_H
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include "repeat.h"
+#include "replicate_selected.h"
+
+/// Selection with probabilities growing linearly with the rank of a specimen
+/**
+Instead of sorting the population, each specimen is picked in a binary
+tournament won by the better contestant with probability `pressure / 2`,
+which yields the same linear ranking distribution as the population size
+grows. The selection pressure must lie in the range [1, 2], where 1 means
+uniform selection and 2 means the worst specimen is never picked.
+*/
+template<class UniformRandomBitGenerator, class Compare = std::less<>>
+class linear_rank_selection {
+public:
+	explicit linear_rank_selection(UniformRandomBitGenerator& g, double pressure = 2.0, const Compare& comp = Compare());
+	template<class Specimen, class Allocator>
+	void operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n);
+private:
+	UniformRandomBitGenerator& rand;
+	std::bernoulli_distribution distribution;
+	Compare comparator;
+	std::pmr::vector<std::size_t> counts;
+};
+
+template<class UniformRandomBitGenerator, class Compare>
+inline linear_rank_selection<UniformRandomBitGenerator, Compare>::linear_rank_selection(UniformRandomBitGenerator& g, double pressure, const Compare& comp)
+	: rand(g), distribution(pressure / 2.0), comparator(comp) {
+	Expects(pressure >= 1.0 && pressure <= 2.0);
+}
+
+template<class UniformRandomBitGenerator, class Compare>
+template<class Specimen, class Allocator>
+inline void linear_rank_selection<UniformRandomBitGenerator, Compare>::operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n) {
+	Expects(specimens.size() >= n);
+	if (n == 0) {
+		specimens.clear();
+		return;
+	}
+	counts.assign(specimens.size(), 0);
+	std::uniform_int_distribution<std::size_t> contestant(0, specimens.size() - 1);
+	repeat(n, [&] {
+		std::size_t better = contestant(rand);
+		std::size_t worse = contestant(rand);
+		if (comparator(specimens[better].rating(), specimens[worse].rating()))
+			std::swap(better, worse);
+		counts[distribution(rand) ? better : worse]++;
+	});
+	replicate_selected(specimens, counts, n);
+}
+
+#endif
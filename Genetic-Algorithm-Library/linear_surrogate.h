@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_LINEAR_SURROGATE_H
+#define GENETIC_ALGORITHM_LIBRARY_LINEAR_SURROGATE_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <gsl/gsl_assert>
+
+/// Ridge regression of ratings on a fixed number of features, refitted online.
+/**
+Every exact rating updates the normal equations, scaled down by
+\a forgetting first so that older generations weigh less. The weights
+are solved for again, by Gaussian elimination, on the first prediction
+after an update.
+
+@tparam Dimension Number of features describing a specimen
+*/
+template<std::size_t Dimension>
+class linear_surrogate {
+public:
+	using feature_type = std::array<double, Dimension>;
+	explicit linear_surrogate(double forgetting = 1.0, double regularization = 1e-6);
+	bool ready() const noexcept;
+	void learn(const feature_type& features, double rating);
+	double predict(const feature_type& features);
+private:
+	static constexpr std::size_t size = Dimension + 1;
+	static std::array<double, size> extend(const feature_type& features) noexcept;
+	void solve();
+	double forgetting;
+	double regularization;
+	std::size_t samples = 0;
+	bool dirty = false;
+	std::array<std::array<double, size>, size> gram {};
+	std::array<double, size> moments {};
+	std::array<double, size> weights {};
+};
+
+template<std::size_t Dimension>
+inline linear_surrogate<Dimension>::linear_surrogate(double forgetting, double regularization)
+	: forgetting(forgetting), regularization(regularization) {
+	Expects(forgetting > 0.0 && forgetting <= 1.0);
+	Expects(regularization >= 0.0);
+}
+
+template<std::size_t Dimension>
+inline bool linear_surrogate<Dimension>::ready() const noexcept {
+	return samples >= 2 * size;
+}
+
+template<std::size_t Dimension>
+inline void linear_surrogate<Dimension>::learn(const feature_type& features, double rating) {
+	const std::array<double, size> x = extend(features);
+	for (std::size_t i = 0; i < size; i++) {
+		for (std::size_t j = 0; j < size; j++) {
+			gram[i][j] = forgetting * gram[i][j] + x[i] * x[j];
+		}
+		moments[i] = forgetting * moments[i] + x[i] * rating;
+	}
+	samples++;
+	dirty = true;
+}
+
+template<std::size_t Dimension>
+inline double linear_surrogate<Dimension>::predict(const feature_type& features) {
+	Expects(ready());
+	if (dirty)
+		solve();
+	const std::array<double, size> x = extend(features);
+	double result = 0.0;
+	for (std::size_t i = 0; i < size; i++) {
+		result += weights[i] * x[i];
+	}
+	return result;
+}
+
+template<std::size_t Dimension>
+inline auto linear_surrogate<Dimension>::extend(const feature_type& features) noexcept -> std::array<double, size> {
+	std::array<double, size> result;
+	for (std::size_t i = 0; i < Dimension; i++) {
+		result[i] = features[i];
+	}
+	result[Dimension] = 1.0;
+	return result;
+}
+
+template<std::size_t Dimension>
+inline void linear_surrogate<Dimension>::solve() {
+	auto a = gram;
+	auto b = moments;
+	for (std::size_t i = 0; i < size; i++) {
+		a[i][i] += regularization * (1.0 + a[i][i]);
+	}
+	for (std::size_t column = 0; column < size; column++) {
+		std::size_t pivot = column;
+		for (std::size_t row = column + 1; row < size; row++) {
+			if (std::abs(a[row][column]) > std::abs(a[pivot][column]))
+				pivot = row;
+		}
+		std::swap(a[column], a[pivot]);
+		std::swap(b[column], b[pivot]);
+		if (a[column][column] == 0.0)
+			continue;
+		for (std::size_t row = column + 1; row < size; row++) {
+			const double factor = a[row][column] / a[column][column];
+			for (std::size_t k = column; k < size; k++) {
+				a[row][k] -= factor * a[column][k];
+			}
+			b[row] -= factor * b[column];
+		}
+	}
+	for (std::size_t i = size; i-- > 0;) {
+		double sum = b[i];
+		for (std::size_t k = i + 1; k < size; k++) {
+			sum -= a[i][k] * weights[k];
+		}
+		weights[i] = a[i][i] != 0.0 ? sum / a[i][i] : 0.0;
+	}
+	dirty = false;
+}
+
+#endif
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_MAPPED_FILE_H
+#define GENETIC_ALGORITHM_LIBRARY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <gsl/gsl_assert>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// A file mapped into memory in its entirety, shared with other processes mapping it.
+/**
+A \c temporary file is truncated when opened and removed when closed. A
+\c persistent file keeps its contents and is only extended, with zeros,
+when it is shorter than \a size.
+*/
+class mapped_file {
+public:
+	enum struct mode { temporary, persistent };
+	mapped_file(const std::string& path, std::size_t size, mode how);
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+	~mapped_file();
+	std::byte* data() const noexcept;
+	std::size_t size() const noexcept;
+private:
+	std::byte* base = nullptr;
+	std::size_t length;
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#else
+	std::string file_path;
+	mode file_mode;
+#endif
+};
+
+#ifdef _WIN32
+
+inline mapped_file::mapped_file(const std::string& path, std::size_t size, mode how)
+	: length(size) {
+	Expects(length > 0);
+	if (how == mode::temporary)
+		file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+	else
+		file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::system_error(GetLastError(), std::system_category(), "cannot open " + path);
+	const std::uint64_t bytes = length;
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, DWORD(bytes >> 32), DWORD(bytes), nullptr);
+	if (mapping == nullptr) {
+		const DWORD error = GetLastError();
+		CloseHandle(file);
+		throw std::system_error(error, std::system_category(), "cannot map " + path);
+	}
+	base = static_cast<std::byte*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, length));
+	if (base == nullptr) {
+		const DWORD error = GetLastError();
+		CloseHandle(mapping);
+		CloseHandle(file);
+		throw std::system_error(error, std::system_category(), "cannot map " + path);
+	}
+}
+
+inline mapped_file::~mapped_file() {
+	UnmapViewOfFile(base);
+	CloseHandle(mapping);
+	CloseHandle(file);
+}
+
+#else
+
+inline mapped_file::mapped_file(const std::string& path, std::size_t size, mode how)
+	: length(size), file_path(path), file_mode(how) {
+	Expects(length > 0);
+	const int flags = how == mode::temporary ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR | O_CREAT;
+	const int descriptor = ::open(path.c_str(), flags, 0600);
+	if (descriptor < 0)
+		throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+	const auto fail = [&](const char* what) {
+		const int error = errno;
+		::close(descriptor);
+		if (how == mode::temporary)
+			::unlink(path.c_str());
+		throw std::system_error(error, std::generic_category(), what + path);
+	};
+	struct stat status;
+	if (::fstat(descriptor, &status) != 0)
+		fail("cannot inspect ");
+	if (std::uint64_t(status.st_size) < length && ::ftruncate(descriptor, off_t(length)) != 0)
+		fail("cannot resize ");
+	void* const address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	if (address == MAP_FAILED)
+		fail("cannot map ");
+	::close(descriptor);
+	base = static_cast<std::byte*>(address);
+}
+
+inline mapped_file::~mapped_file() {
+	::munmap(base, length);
+	if (file_mode == mode::temporary)
+		::unlink(file_path.c_str());
+}
+
+#endif
+
+inline std::byte* mapped_file::data() const noexcept {
+	return base;
+}
+
+inline std::size_t mapped_file::size() const noexcept {
+	return length;
+}
+
+#endif
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_MAPPED_FILE_RESOURCE_H
+#define GENETIC_ALGORITHM_LIBRARY_MAPPED_FILE_RESOURCE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <set>
+#include <string>
+#include <utility>
+#include <gsl/gsl_assert>
+#include "mapped_file.h"
+
+/// Memory resource handing out blocks of a memory-mapped scratch file.
+/**
+The whole file is mapped once, so its pages are written back to disk and
+evicted by the operating system instead of being swapped, and only the
+pages that were touched take up space on disk. The file is removed when
+the resource is destroyed. Freed blocks are merged with their neighbours.
+They are indexed by size as well as by address, so an allocation takes
+the smallest free block that fits in logarithmic time.
+*/
+class mapped_file_resource : public std::pmr::memory_resource {
+public:
+	mapped_file_resource(const std::string& path, std::size_t capacity);
+	std::size_t capacity() const noexcept;
+	bool contains(const void* p) const noexcept;
+private:
+	static constexpr std::size_t granularity = alignof(std::max_align_t);
+	static constexpr std::size_t round_up(std::size_t value, std::size_t alignment) noexcept;
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	void release(std::size_t offset, std::size_t size);
+	void insert_block(std::size_t offset, std::size_t length);
+	std::map<std::size_t, std::size_t>::iterator erase_block(std::map<std::size_t, std::size_t>::iterator block);
+	mapped_file file;
+	std::byte* base;
+	std::size_t size;
+	std::map<std::size_t, std::size_t> free_blocks;
+	std::set<std::pair<std::size_t, std::size_t>> free_sizes;
+	std::mutex mutex;
+};
+
+inline mapped_file_resource::mapped_file_resource(const std::string& path, std::size_t capacity)
+	: file(path, round_up(capacity, granularity), mapped_file::mode::temporary), base(file.data()), size(file.size()) {
+	insert_block(0, size);
+}
+
+inline std::size_t mapped_file_resource::capacity() const noexcept {
+	return size;
+}
+
+inline bool mapped_file_resource::contains(const void* p) const noexcept {
+	const auto address = reinterpret_cast<std::uintptr_t>(p);
+	const auto first = reinterpret_cast<std::uintptr_t>(base);
+	return address >= first && address - first < size;
+}
+
+constexpr std::size_t mapped_file_resource::round_up(std::size_t value, std::size_t alignment) noexcept {
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+inline void* mapped_file_resource::do_allocate(std::size_t bytes, std::size_t alignment) {
+	bytes = round_up(bytes, granularity);
+	alignment = std::max(alignment, granularity);
+	std::lock_guard lock(mutex);
+	const auto block = free_sizes.lower_bound({bytes + alignment - granularity, 0});
+	if (block == free_sizes.end())
+		throw std::bad_alloc();
+	const auto [length, offset] = *block;
+	const std::size_t first = round_up(reinterpret_cast<std::uintptr_t>(base + offset), alignment) - reinterpret_cast<std::uintptr_t>(base);
+	erase_block(free_blocks.find(offset));
+	if (first > offset)
+		insert_block(offset, first - offset);
+	if (offset + length > first + bytes)
+		insert_block(first + bytes, offset + length - first - bytes);
+	return base + first;
+}
+
+inline void mapped_file_resource::do_deallocate(void* p, std::size_t bytes, std::size_t) {
+	Expects(contains(p));
+	std::lock_guard lock(mutex);
+	release(static_cast<std::byte*>(p) - base, round_up(bytes, granularity));
+}
+
+inline bool mapped_file_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
+
+inline void mapped_file_resource::release(std::size_t offset, std::size_t length) {
+	auto next = free_blocks.lower_bound(offset);
+	if (next != free_blocks.end() && offset + length == next->first) {
+		length += next->second;
+		next = erase_block(next);
+	}
+	if (next != free_blocks.begin()) {
+		const auto previous = std::prev(next);
+		if (previous->first + previous->second == offset) {
+			offset = previous->first;
+			length += previous->second;
+			erase_block(previous);
+		}
+	}
+	insert_block(offset, length);
+}
+
+inline void mapped_file_resource::insert_block(std::size_t offset, std::size_t length) {
+	free_blocks.emplace(offset, length);
+	free_sizes.emplace(length, offset);
+}
+
+inline auto mapped_file_resource::erase_block(std::map<std::size_t, std::size_t>::iterator block) -> std::map<std::size_t, std::size_t>::iterator {
+	free_sizes.erase({block->second, block->first});
+	return free_blocks.erase(block);
+}
+
+#endif
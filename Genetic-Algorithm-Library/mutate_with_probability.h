@@ -25,7 +25,7 @@
 #ifndef GENETIC_ALGORITHM_LIBRARY_MUTATE_WITH_PROBABILITY_H
 #define GENETIC_ALGORITHM_LIBRARY_MUTATE_WITH_PROBABILITY_H
 
-#include <random>
+#include "bulk_distribution.h"
 
 template<class UniformRandomBitGenerator, class Mutator>
 class mutate_with_probability {
@@ -35,7 +35,7 @@ public:
 	void operator()(Specimen& specimen);
 private:
 	UniformRandomBitGenerator& rand;
-	std::bernoulli_distribution distribution;
+	bulk_bernoulli_distribution distribution;
 	Mutator mutator;
 };
 
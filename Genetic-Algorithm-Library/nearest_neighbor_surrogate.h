@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_NEAREST_NEIGHBOR_SURROGATE_H
+#define GENETIC_ALGORITHM_LIBRARY_NEAREST_NEIGHBOR_SURROGATE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+
+/// Predicts a rating as the mean rating of the \a k nearest of the most recently rated specimens.
+/**
+Only the last \a memory exact ratings are kept, so the model follows the
+population as it moves. Predictions scan all of them, which is cheap next
+to the evaluations the model is meant to replace.
+
+@tparam Dimension Number of features describing a specimen
+*/
+template<std::size_t Dimension>
+class nearest_neighbor_surrogate {
+public:
+	using feature_type = std::array<double, Dimension>;
+	explicit nearest_neighbor_surrogate(std::size_t k = 8, std::size_t memory = 1024);
+	bool ready() const noexcept;
+	void learn(const feature_type& features, double rating);
+	double predict(const feature_type& features);
+private:
+	struct sample_type {
+		feature_type features;
+		double rating;
+	};
+	std::size_t neighbors;
+	std::size_t memory;
+	std::size_t next = 0;
+	std::pmr::vector<sample_type> samples;
+	std::pmr::vector<std::pair<double, double>> distances;
+};
+
+template<std::size_t Dimension>
+inline nearest_neighbor_surrogate<Dimension>::nearest_neighbor_surrogate(std::size_t k, std::size_t memory)
+	: neighbors(k), memory(memory) {
+	Expects(neighbors > 0);
+	Expects(memory >= neighbors);
+	samples.reserve(memory);
+}
+
+template<std::size_t Dimension>
+inline bool nearest_neighbor_surrogate<Dimension>::ready() const noexcept {
+	return samples.size() >= neighbors;
+}
+
+template<std::size_t Dimension>
+inline void nearest_neighbor_surrogate<Dimension>::learn(const feature_type& features, double rating) {
+	if (samples.size() < memory)
+		samples.push_back({features, rating});
+	else
+		samples[next] = {features, rating};
+	next = (next + 1) % memory;
+}
+
+template<std::size_t Dimension>
+inline double nearest_neighbor_surrogate<Dimension>::predict(const feature_type& features) {
+	Expects(ready());
+	distances.clear();
+	for (const sample_type& sample : samples) {
+		double distance = 0.0;
+		for (std::size_t i = 0; i < Dimension; i++) {
+			const double difference = sample.features[i] - features[i];
+			distance += difference * difference;
+		}
+		distances.emplace_back(distance, sample.rating);
+	}
+	std::nth_element(distances.begin(), distances.begin() + (neighbors - 1), distances.end());
+	double sum = 0.0;
+	for (std::size_t i = 0; i < neighbors; i++) {
+		sum += distances[i].second;
+	}
+	return sum / neighbors;
+}
+
+#endif
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_PARALLEL_GENERATOR_H
+#define GENETIC_ALGORITHM_LIBRARY_PARALLEL_GENERATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include "trace_recorder.h"
+
+/// Generator producing specimens in parallel batches from independently seeded engines
+/**
+Specimens are built \a batch_size at a time with a parallel policy and
+handed out one by one, so an expensive construction heuristic plugged
+into \c context.generator fills the initial population on every core.
+The seed of every specimen is drawn sequentially from \a engine before
+the batch starts, which keeps a run with a fixed seed reproducible
+regardless of thread scheduling. Give \a engine a stream of its own from
+a \c random_stream_family, so the seeds are not the numbers other
+operators draw. \a function is called concurrently as
+<tt>function(Engine&)</tt> and must not modify shared state. Every
+specimen built is recorded as a span by the current \c trace_recorder.
+*/
+template<class Engine, class Function>
+class parallel_generator {
+public:
+	using engine_type = Engine;
+	using result_type = std::decay_t<std::invoke_result_t<const Function&, engine_type&>>;
+	parallel_generator(const engine_type& engine, std::size_t batch_size, const Function& function);
+	result_type operator()();
+private:
+	void refill();
+	engine_type rand;
+	std::size_t batch_size;
+	Function function;
+	std::vector<typename engine_type::result_type> seeds;
+	std::vector<result_type> batch;
+	std::size_t position;
+};
+
+template<class Engine, class Function>
+inline parallel_generator<Engine, Function>::parallel_generator(const engine_type& engine, std::size_t batch_size, const Function& function)
+	: rand(engine), batch_size(batch_size), function(function), position(0) {
+	Expects(batch_size > 0);
+}
+
+template<class Engine, class Function>
+inline auto parallel_generator<Engine, Function>::operator()() -> result_type {
+	if (position == batch.size())
+		refill();
+	return std::move(batch[position++]);
+}
+
+template<class Engine, class Function>
+inline void parallel_generator<Engine, Function>::refill() {
+	seeds.resize(batch_size);
+	std::generate(seeds.begin(), seeds.end(), std::ref(rand));
+	batch.resize(batch_size);
+	std::transform(std::execution::par, seeds.begin(), seeds.end(), batch.begin(), [this](typename engine_type::result_type seed) {
+		trace_span span("construct", "worker");
+		engine_type engine(seed);
+		return function(engine);
+	});
+	position = 0;
+}
+
+#endif
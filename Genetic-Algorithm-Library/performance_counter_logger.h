@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_PERFORMANCE_COUNTER_LOGGER_H
+#define GENETIC_ALGORITHM_LIBRARY_PERFORMANCE_COUNTER_LOGGER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <gsl/gsl_util>
+#include "performance_counters.h"
+
+/// Observer writing the hardware performance counters of every phase of the algorithm.
+/**
+The counters of the generate, evaluate, select and breed phases are
+written per generation, when it has been bred, and summed up over the
+whole run by \c write_totals. Only the thread running the algorithm is
+counted, so in the pipelined mode the evaluate phase is the time spent
+waiting for the worker threads. Counters that are not available are left
+out; when none is, that is written once instead.
+*/
+template<class CharT, class Traits>
+class performance_counter_logger {
+public:
+	using ostream_type = std::basic_ostream<CharT, Traits>;
+	explicit performance_counter_logger(ostream_type& out);
+	explicit performance_counter_logger(ostream_type&&) = delete;
+	template<class Algorithm>
+	void enter(const Algorithm&, typename Algorithm::phase_type phase);
+	template<class Algorithm>
+	void leave(const Algorithm&, typename Algorithm::phase_type phase);
+	template<class Algorithm>
+	void operator()(const Algorithm&, typename Algorithm::stage_type stage, const typename Algorithm::population_type&);
+	void write_totals();
+private:
+	using values_type = performance_counters::values_type;
+	// in the order of genetic_algorithm::phase_type
+	static constexpr std::array<const char*, 4> phase_names {{"generate", "evaluate", "select", "breed"}};
+	using phase_values_type = std::array<values_type, phase_names.size()>;
+	void write(const phase_values_type& values);
+	performance_counters counters;
+	ostream_type& out;
+	values_type start {};
+	phase_values_type generation_values {};
+	phase_values_type total_values {};
+	std::size_t generation = 0;
+};
+
+template<class CharT, class Traits>
+inline performance_counter_logger<CharT, Traits>::performance_counter_logger(ostream_type& out)
+	: out(out) {}
+
+template<class CharT, class Traits>
+template<class Algorithm>
+inline void performance_counter_logger<CharT, Traits>::enter(const Algorithm&, typename Algorithm::phase_type) {
+	start = counters.read();
+}
+
+template<class CharT, class Traits>
+template<class Algorithm>
+inline void performance_counter_logger<CharT, Traits>::leave(const Algorithm&, typename Algorithm::phase_type phase) {
+	const values_type current = counters.read();
+	values_type& values = gsl::at(generation_values, static_cast<std::size_t>(phase));
+	for (std::size_t i = 0; i < values.size(); i++) {
+		values[i] += current[i] - start[i];
+	}
+}
+
+template<class CharT, class Traits>
+template<class Algorithm>
+inline void performance_counter_logger<CharT, Traits>::operator()(const Algorithm&, typename Algorithm::stage_type stage, const typename Algorithm::population_type&) {
+	using stage_type = typename Algorithm::stage_type;
+	if (stage == stage_type::selected)
+		return;
+	if (!counters.any_available()) {
+		if (stage == stage_type::generated)
+			out << "Performance counters are unavailable\n";
+		return;
+	}
+	if (stage == stage_type::generated)
+		generation = 0;
+	out << "Generation " << generation++ << '\n';
+	write(generation_values);
+	for (std::size_t i = 0; i < generation_values.size(); i++) {
+		for (std::size_t j = 0; j < generation_values[i].size(); j++) {
+			total_values[i][j] += generation_values[i][j];
+		}
+	}
+	generation_values = {};
+}
+
+template<class CharT, class Traits>
+inline void performance_counter_logger<CharT, Traits>::write_totals() {
+	if (!counters.any_available())
+		return;
+	out << "Total\n";
+	write(total_values);
+}
+
+template<class CharT, class Traits>
+inline void performance_counter_logger<CharT, Traits>::write(const phase_values_type& values) {
+	using event_type = performance_counters::event_type;
+	for (std::size_t i = 0; i < values.size(); i++) {
+		if (values[i] == values_type {})
+			continue;
+		out << '\t' << phase_names[i] << ':';
+		const char* separator = " ";
+		for (std::size_t j = 0; j < performance_counters::event_count; j++) {
+			const auto event = static_cast<event_type>(j);
+			if (!counters.available(event))
+				continue;
+			out << separator << values[i][j] << ' ' << performance_counters::name(event);
+			separator = ", ";
+		}
+		const std::uint64_t cycles = values[i][static_cast<std::size_t>(event_type::cycles)];
+		if (cycles > 0 && counters.available(event_type::instructions))
+			out << " (" << static_cast<double>(values[i][static_cast<std::size_t>(event_type::instructions)]) / cycles << " instructions per cycle)";
+		out << '\n';
+	}
+}
+
+#endif
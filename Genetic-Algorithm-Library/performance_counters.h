@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_PERFORMANCE_COUNTERS_H
+#define GENETIC_ALGORITHM_LIBRARY_PERFORMANCE_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <gsl/gsl_util>
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// Hardware performance counters of the calling thread
+/**
+Counts cycles, instructions, cache misses (usually of the last level
+cache) and branch misses in user space, together with the task clock in
+nanoseconds, through \c perf_event_open. Every counter is opened on its
+own, so those the kernel or the processor does not provide, as is common
+in virtual machines, in containers and with a restrictive
+\c perf_event_paranoid setting, are simply unavailable and read as zero
+while the others keep counting. Counters multiplexed by the kernel are
+scaled to the whole time they were enabled. On systems other than Linux
+no counter is available.
+
+The counters start when constructed and run until destroyed. Only the
+thread that constructed them is counted.
+*/
+class performance_counters {
+public:
+	enum struct event_type { cycles, instructions, cache_misses, branch_misses, task_clock };
+	static constexpr std::size_t event_count = 5;
+	using values_type = std::array<std::uint64_t, event_count>;
+	performance_counters();
+	performance_counters(const performance_counters&) = delete;
+	performance_counters& operator=(const performance_counters&) = delete;
+	~performance_counters();
+	bool available(event_type event) const noexcept;
+	bool any_available() const noexcept;
+	values_type read() const;
+	static const char* name(event_type event) noexcept;
+private:
+	std::array<int, event_count> descriptors;
+	int leader = -1;
+};
+
+#ifdef __linux__
+
+inline performance_counters::performance_counters() {
+	static constexpr std::array<std::pair<std::uint32_t, std::uint64_t>, event_count> events {{
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+		{PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+	}};
+	for (std::size_t i = 0; i < event_count; i++) {
+		perf_event_attr attributes;
+		std::memset(&attributes, 0, sizeof(attributes));
+		attributes.size = sizeof(attributes);
+		attributes.type = events[i].first;
+		attributes.config = events[i].second;
+		attributes.disabled = leader == -1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		descriptors[i] = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, leader, 0));
+		if (leader == -1)
+			leader = descriptors[i];
+	}
+	if (leader != -1) {
+		ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+}
+
+inline performance_counters::~performance_counters() {
+	for (const int descriptor : descriptors) {
+		if (descriptor != -1)
+			close(descriptor);
+	}
+}
+
+inline auto performance_counters::read() const -> values_type {
+	values_type result {};
+	if (leader == -1)
+		return result;
+	std::array<std::uint64_t, 3 + event_count> buffer;
+	if (::read(leader, buffer.data(), sizeof(buffer)) < 0)
+		throw std::system_error(errno, std::generic_category(), "cannot read performance counters");
+	const std::uint64_t enabled = buffer[1];
+	const std::uint64_t running = buffer[2];
+	if (running == 0)
+		return result;
+	std::size_t index = 3;
+	for (std::size_t i = 0; i < event_count; i++) {
+		if (descriptors[i] == -1)
+			continue;
+		const std::uint64_t value = gsl::at(buffer, index++);
+		result[i] = running < enabled ? static_cast<std::uint64_t>(static_cast<long double>(value) * enabled / running) : value;
+	}
+	return result;
+}
+
+#else
+
+inline performance_counters::performance_counters() {
+	descriptors.fill(-1);
+}
+
+inline performance_counters::~performance_counters() = default;
+
+inline auto performance_counters::read() const -> values_type {
+	return {};
+}
+
+#endif
+
+inline bool performance_counters::available(event_type event) const noexcept {
+	return descriptors[static_cast<std::size_t>(event)] != -1;
+}
+
+inline bool performance_counters::any_available() const noexcept {
+	return leader != -1;
+}
+
+inline const char* performance_counters::name(event_type event) noexcept {
+	switch (event) {
+		case event_type::cycles:
+			return "cycles";
+		case event_type::instructions:
+			return "instructions";
+		case event_type::cache_misses:
+			return "cache misses";
+		case event_type::branch_misses:
+			return "branch misses";
+		case event_type::task_clock:
+			return "ns";
+	}
+	return "";
+}
+
+#endif
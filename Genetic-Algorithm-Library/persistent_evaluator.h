@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_PERSISTENT_EVALUATOR_H
+#define GENETIC_ALGORITHM_LIBRARY_PERSISTENT_EVALUATOR_H
+
+#include <optional>
+#include "persistent_rating_table.h"
+
+/// Evaluator looking ratings up in a \c persistent_rating_table before computing them.
+/**
+The \a encoder turns a specimen into the key it is stored under, so it
+decides which specimens count as the same one; a 128-bit hash of a
+canonical form, such as \c std::array<std::uint64_t, 2>, makes collisions
+negligible. Ratings computed by \a evaluator are stored for other runs and
+processes sharing the table.
+*/
+template<class Key, class Rating, class Encoder, class Evaluator>
+class persistent_evaluator {
+public:
+	persistent_evaluator(persistent_rating_table<Key, Rating>& table, const Encoder& encoder, const Evaluator& evaluator);
+	template<class Specimen>
+	Rating operator()(const Specimen& specimen);
+private:
+	persistent_rating_table<Key, Rating>& table;
+	Encoder encoder;
+	Evaluator evaluator;
+};
+
+template<class Key, class Rating, class Encoder, class Evaluator>
+inline persistent_evaluator<Key, Rating, Encoder, Evaluator>::persistent_evaluator(persistent_rating_table<Key, Rating>& table, const Encoder& encoder, const Evaluator& evaluator)
+	: table(table), encoder(encoder), evaluator(evaluator) {}
+
+template<class Key, class Rating, class Encoder, class Evaluator>
+template<class Specimen>
+inline Rating persistent_evaluator<Key, Rating, Encoder, Evaluator>::operator()(const Specimen& specimen) {
+	const Key key = encoder(specimen);
+	if (const std::optional<Rating> rating = table.find(key))
+		return *rating;
+	const Rating rating = evaluator(specimen);
+	table.insert(key, rating);
+	return rating;
+}
+
+#endif
@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_PERSISTENT_RATING_TABLE_H
+#define GENETIC_ALGORITHM_LIBRARY_PERSISTENT_RATING_TABLE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <gsl/gsl_assert>
+#include "mapped_file.h"
+
+/// Open-addressing hash table of ratings kept in a memory-mapped file.
+/**
+Several processes may open the same file and look up or insert ratings
+concurrently. Every slot is claimed with an atomic compare-and-swap on its
+state and published once its key and rating are written, so readers never
+see a partially written entry. Entries are never removed; once the table
+is seven-eighths full new ratings are no longer stored.
+
+The first process to open a new file writes its header. A file whose
+header does not match the table, in size or layout, is rejected with
+\c std::runtime_error. If the process writing the header dies before it
+is done, another one takes over once the header has not changed for
+\c initialization_timeout.
+
+@tparam Key    Trivially copyable key encoding a specimen, compared bytewise
+@tparam Rating Trivially copyable rating
+*/
+template<class Key, class Rating>
+class persistent_rating_table {
+public:
+	using key_type = Key;
+	using rating_type = Rating;
+	persistent_rating_table(const std::string& path, std::size_t capacity);
+	std::optional<rating_type> find(const key_type& key) const;
+	bool insert(const key_type& key, const rating_type& rating);
+	std::size_t capacity() const noexcept;
+	std::size_t size() const noexcept;
+private:
+	static_assert(std::is_trivially_copyable_v<Key> && std::has_unique_object_representations_v<Key>, "keys are hashed and compared bytewise");
+	static_assert(std::is_trivially_copyable_v<Rating>, "ratings are stored bytewise");
+	static_assert(std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<std::uint64_t>::is_always_lock_free, "shared atomics must be lock free");
+	static constexpr std::uint64_t magic = 0x4741524154494e47;
+	static constexpr std::uint64_t initializing = 1;
+	static constexpr std::uint64_t max_claims = 16;
+	static constexpr std::chrono::seconds initialization_timeout {5};
+	enum slot_state : std::uint32_t { empty, writing, ready };
+	struct alignas(64) header_type {
+		std::atomic<std::uint64_t> signature;
+		std::uint64_t slot_count;
+		std::uint64_t key_size;
+		std::uint64_t rating_size;
+		std::atomic<std::uint64_t> count;
+	};
+	struct slot_type {
+		std::atomic<std::uint32_t> state;
+		key_type key;
+		rating_type rating;
+	};
+	static std::uint64_t hash(const key_type& key) noexcept;
+	static std::size_t file_size(std::size_t capacity) noexcept;
+	header_type& header() const noexcept;
+	slot_type& slot(std::size_t index) const noexcept;
+	mapped_file file;
+	std::size_t mask;
+};
+
+template<class Key, class Rating>
+inline persistent_rating_table<Key, Rating>::persistent_rating_table(const std::string& path, std::size_t capacity)
+	: file(path, file_size(capacity), mapped_file::mode::persistent), mask(capacity - 1) {
+	Expects(capacity > 0 && (capacity & (capacity - 1)) == 0);
+	header_type& head = header();
+	std::uint64_t signature = head.signature.load(std::memory_order_acquire);
+	auto deadline = std::chrono::steady_clock::now() + initialization_timeout;
+	while (signature != magic) {
+		if (signature >= initializing + max_claims)
+			throw std::runtime_error(path + " is not a rating table");
+		if (signature == 0 || std::chrono::steady_clock::now() >= deadline) {
+			// claims after the first take over from a process that died while writing the header
+			if (head.signature.compare_exchange_strong(signature, signature + 1, std::memory_order_acq_rel)) {
+				head.slot_count = capacity;
+				head.key_size = sizeof(key_type);
+				head.rating_size = sizeof(rating_type);
+				head.signature.store(magic, std::memory_order_release);
+				signature = magic;
+			} else {
+				deadline = std::chrono::steady_clock::now() + initialization_timeout;
+			}
+			continue;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		const std::uint64_t current = head.signature.load(std::memory_order_acquire);
+		if (current != signature) {
+			signature = current;
+			deadline = std::chrono::steady_clock::now() + initialization_timeout;
+		}
+	}
+	if (head.slot_count != capacity)
+		throw std::runtime_error(path + " holds a rating table of a different capacity");
+	if (head.key_size != sizeof(key_type) || head.rating_size != sizeof(rating_type))
+		throw std::runtime_error(path + " holds a rating table of different key or rating types");
+}
+
+template<class Key, class Rating>
+inline auto persistent_rating_table<Key, Rating>::find(const key_type& key) const -> std::optional<rating_type> {
+	for (std::size_t i = hash(key) & mask, probes = 0; probes <= mask; i = (i + 1) & mask, probes++) {
+		const slot_type& current = slot(i);
+		const std::uint32_t state = current.state.load(std::memory_order_acquire);
+		if (state == empty)
+			break;
+		if (state == ready && std::memcmp(&current.key, &key, sizeof(key_type)) == 0)
+			return current.rating;
+	}
+	return std::nullopt;
+}
+
+template<class Key, class Rating>
+inline bool persistent_rating_table<Key, Rating>::insert(const key_type& key, const rating_type& rating) {
+	header_type& head = header();
+	if (head.count.load(std::memory_order_relaxed) >= capacity() - capacity() / 8)
+		return false;
+	for (std::size_t i = hash(key) & mask, probes = 0; probes <= mask; i = (i + 1) & mask, probes++) {
+		slot_type& current = slot(i);
+		std::uint32_t state = empty;
+		if (current.state.compare_exchange_strong(state, writing, std::memory_order_acquire)) {
+			std::memcpy(&current.key, &key, sizeof(key_type));
+			std::memcpy(&current.rating, &rating, sizeof(rating_type));
+			current.state.store(ready, std::memory_order_release);
+			head.count.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+		if (state == ready && std::memcmp(&current.key, &key, sizeof(key_type)) == 0)
+			return false;
+	}
+	return false;
+}
+
+template<class Key, class Rating>
+inline std::size_t persistent_rating_table<Key, Rating>::capacity() const noexcept {
+	return mask + 1;
+}
+
+template<class Key, class Rating>
+inline std::size_t persistent_rating_table<Key, Rating>::size() const noexcept {
+	return header().count.load(std::memory_order_relaxed);
+}
+
+template<class Key, class Rating>
+inline std::uint64_t persistent_rating_table<Key, Rating>::hash(const key_type& key) noexcept {
+	unsigned char bytes[sizeof(key_type)];
+	std::memcpy(bytes, &key, sizeof(key_type));
+	std::uint64_t result = 0xcbf29ce484222325;
+	for (const unsigned char byte : bytes) {
+		result = (result ^ byte) * 0x100000001b3;
+	}
+	result = (result ^ (result >> 30)) * 0xbf58476d1ce4e5b9;
+	result = (result ^ (result >> 27)) * 0x94d049bb133111eb;
+	return result ^ (result >> 31);
+}
+
+template<class Key, class Rating>
+inline std::size_t persistent_rating_table<Key, Rating>::file_size(std::size_t capacity) noexcept {
+	return sizeof(header_type) + capacity * sizeof(slot_type);
+}
+
+template<class Key, class Rating>
+inline auto persistent_rating_table<Key, Rating>::header() const noexcept -> header_type& {
+	return *reinterpret_cast<header_type*>(file.data());
+}
+
+template<class Key, class Rating>
+inline auto persistent_rating_table<Key, Rating>::slot(std::size_t index) const noexcept -> slot_type& {
+	return reinterpret_cast<slot_type*>(file.data() + sizeof(header_type))[index];
+}
+
+#endif
@@ -0,0 +1,495 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_PROCESS_EVALUATOR_H
+#define GENETIC_ALGORITHM_LIBRARY_PROCESS_EVALUATOR_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include "child_process.h"
+
+/// Evaluator rating specimens in a pool of long-lived worker processes.
+/**
+Every worker runs \a command and is sent one request per line on its
+standard input, <tt>id specimen</tt>, where the specimen is written by
+\a encoder, by default with \c operator<<, and must not contain a line
+break. It answers each request with a line <tt>id rating</tt> on its
+standard output, in any order, and should flush its output whenever it
+runs out of input.
+
+Each worker is kept busy with up to \a depth requests in flight. It takes
+the next pending request as soon as one of its own is answered, so
+faster workers get more of the work. A worker that exits or crashes is
+started again, and its unanswered requests are sent to the workers
+again. A request that has been lost this way \c max_attempts times
+fails the evaluation with \c std::runtime_error, since the specimen is
+then likely what crashes the workers.
+
+Given a \a timeout, a request not answered within that time of being
+sent is rated \a timeout_rating, which should be bad enough for the
+specimen to be dropped by selection, and counted by \c timeouts. A
+watchdog thread of the pool, which never waits on the workers, then
+kills the worker, which may be hung, and it is started again like one
+that crashed. Killing it also frees a writer stuck on its full input.
+Up to \a depth requests wait in the input of a worker, so the timeout
+should allow for that many evaluations.
+
+Plug it in as the batch evaluator of the context, which lets a whole
+population be evaluated at once and reports how many of its specimens
+timed out, and also as the evaluator for single specimens. It may be
+called concurrently, and copies share the same workers.
+*/
+template<class Specimen, class Rating>
+class process_evaluator {
+public:
+	using specimen_type = Specimen;
+	using rating_type = Rating;
+	using encoder_type = std::function<void(std::ostream&, const specimen_type&)>;
+	using duration = std::chrono::steady_clock::duration;
+	static constexpr std::size_t max_attempts = 3;
+	process_evaluator(std::vector<std::string> command, std::size_t workers, std::size_t depth = 4, encoder_type encoder = write_specimen);
+	process_evaluator(std::vector<std::string> command, std::size_t workers, duration timeout, const rating_type& timeout_rating, std::size_t depth = 4, encoder_type encoder = write_specimen);
+	rating_type operator()(const specimen_type& specimen) const;
+	template<class Population>
+	std::size_t operator()(Population& specimens) const;
+	std::size_t restarts() const;
+	std::size_t timeouts() const;
+private:
+	static void write_specimen(std::ostream& out, const specimen_type& specimen);
+	class pool_type;
+	std::shared_ptr<pool_type> pool;
+};
+
+template<class Specimen, class Rating>
+class process_evaluator<Specimen, Rating>::pool_type {
+public:
+	pool_type(std::vector<std::string> command, std::size_t worker_count, std::size_t depth, encoder_type encoder, duration timeout, std::optional<rating_type> timeout_rating);
+	pool_type(const pool_type&) = delete;
+	pool_type& operator=(const pool_type&) = delete;
+	~pool_type();
+	std::vector<rating_type> evaluate(const std::vector<const specimen_type*>& specimens, std::size_t& timed_out);
+	std::size_t restarts() const;
+	std::size_t timeouts() const;
+private:
+	struct batch_type {
+		std::vector<std::optional<rating_type>> ratings;
+		std::size_t remaining;
+		std::size_t timed_out;
+		std::exception_ptr failure;
+	};
+	struct request_type {
+		batch_type* batch;
+		std::size_t index;
+		std::shared_ptr<const std::string> line;
+		std::size_t attempts;
+		std::chrono::steady_clock::time_point sent;
+	};
+	struct worker_type {
+		std::shared_ptr<child_process> process;
+		std::unordered_map<std::uint64_t, request_type> in_flight;
+		bool killed = false;
+		std::thread writer;
+		std::thread reader;
+	};
+	void write(worker_type& worker);
+	void read(worker_type& worker);
+	void watch();
+	void restart(worker_type& worker);
+	void expire(worker_type& worker, std::chrono::steady_clock::time_point now);
+	void answer(worker_type& worker, const std::string& line);
+	void fail(const request_type& request, std::exception_ptr failure);
+	void settle(batch_type& batch);
+	const std::vector<std::string> command;
+	const std::size_t depth;
+	const encoder_type encoder;
+	const duration timeout;
+	const std::optional<rating_type> timeout_rating;
+	mutable std::mutex mutex;
+	std::condition_variable work_available;
+	std::condition_variable batch_finished;
+	std::condition_variable request_sent;
+	std::deque<std::pair<std::uint64_t, request_type>> pending;
+	std::uint64_t next_id = 0;
+	std::size_t restart_count = 0;
+	std::size_t timeout_count = 0;
+	bool stopping = false;
+	std::deque<worker_type> workers;
+	std::thread watchdog;
+};
+
+template<class Specimen, class Rating>
+inline process_evaluator<Specimen, Rating>::process_evaluator(std::vector<std::string> command, std::size_t workers, std::size_t depth, encoder_type encoder)
+	: pool(std::make_shared<pool_type>(std::move(command), workers, depth, std::move(encoder), duration::zero(), std::nullopt)) {}
+
+template<class Specimen, class Rating>
+inline process_evaluator<Specimen, Rating>::process_evaluator(std::vector<std::string> command, std::size_t workers, duration timeout, const rating_type& timeout_rating, std::size_t depth, encoder_type encoder)
+	: pool(std::make_shared<pool_type>(std::move(command), workers, depth, std::move(encoder), timeout, timeout_rating)) {
+	Expects(timeout > duration::zero());
+}
+
+template<class Specimen, class Rating>
+inline auto process_evaluator<Specimen, Rating>::operator()(const specimen_type& specimen) const -> rating_type {
+	std::size_t timed_out = 0;
+	return pool->evaluate({&specimen}, timed_out).front();
+}
+
+/// Rates every specimen of \a specimens, returning how many of them were given the timeout rating
+template<class Specimen, class Rating>
+template<class Population>
+inline std::size_t process_evaluator<Specimen, Rating>::operator()(Population& specimens) const {
+	std::vector<const specimen_type*> values;
+	values.reserve(specimens.size());
+	for (const auto& specimen : specimens) {
+		values.push_back(&specimen.value());
+	}
+	std::size_t timed_out = 0;
+	const std::vector<rating_type> ratings = pool->evaluate(values, timed_out);
+	for (std::size_t i = 0; i < ratings.size(); i++) {
+		specimens[i].evaluate([&](const specimen_type&) {
+			return ratings[i];
+		});
+	}
+	return timed_out;
+}
+
+/// Number of times a worker had to be started again
+template<class Specimen, class Rating>
+inline std::size_t process_evaluator<Specimen, Rating>::restarts() const {
+	return pool->restarts();
+}
+
+/// Number of requests that were not answered within the timeout
+template<class Specimen, class Rating>
+inline std::size_t process_evaluator<Specimen, Rating>::timeouts() const {
+	return pool->timeouts();
+}
+
+template<class Specimen, class Rating>
+inline void process_evaluator<Specimen, Rating>::write_specimen(std::ostream& out, const specimen_type& specimen) {
+	out << specimen;
+}
+
+template<class Specimen, class Rating>
+inline process_evaluator<Specimen, Rating>::pool_type::pool_type(std::vector<std::string> command, std::size_t worker_count, std::size_t depth, encoder_type encoder, duration timeout, std::optional<rating_type> timeout_rating)
+	: command(std::move(command)), depth(depth), encoder(std::move(encoder)), timeout(timeout), timeout_rating(std::move(timeout_rating)) {
+	Expects(!this->command.empty());
+	Expects(worker_count > 0);
+	Expects(depth > 0);
+	Expects(this->encoder != nullptr);
+	for (std::size_t i = 0; i < worker_count; i++) {
+		workers.emplace_back();
+		workers.back().process = std::make_shared<child_process>(this->command);
+	}
+	for (worker_type& worker : workers) {
+		worker.writer = std::thread(&pool_type::write, this, std::ref(worker));
+		worker.reader = std::thread(&pool_type::read, this, std::ref(worker));
+	}
+	if (timeout > duration::zero())
+		watchdog = std::thread(&pool_type::watch, this);
+}
+
+template<class Specimen, class Rating>
+inline process_evaluator<Specimen, Rating>::pool_type::~pool_type() {
+	{
+		std::lock_guard lock(mutex);
+		stopping = true;
+		for (worker_type& worker : workers) {
+			if (worker.process != nullptr)
+				worker.process->kill();
+		}
+	}
+	work_available.notify_all();
+	request_sent.notify_all();
+	for (worker_type& worker : workers) {
+		worker.writer.join();
+		worker.reader.join();
+	}
+	if (watchdog.joinable())
+		watchdog.join();
+}
+
+template<class Specimen, class Rating>
+inline auto process_evaluator<Specimen, Rating>::pool_type::evaluate(const std::vector<const specimen_type*>& specimens, std::size_t& timed_out) -> std::vector<rating_type> {
+	batch_type batch {std::vector<std::optional<rating_type>>(specimens.size()), specimens.size(), 0, nullptr};
+	if (specimens.empty())
+		return {};
+	std::uint64_t first_id;
+	{
+		std::lock_guard lock(mutex);
+		first_id = next_id;
+		next_id += specimens.size();
+	}
+	std::vector<std::pair<std::uint64_t, request_type>> requests;
+	requests.reserve(specimens.size());
+	for (std::size_t i = 0; i < specimens.size(); i++) {
+		std::ostringstream line;
+		line << first_id + i << ' ';
+		encoder(line, *specimens[i]);
+		line << '\n';
+		requests.emplace_back(first_id + i, request_type {&batch, i, std::make_shared<const std::string>(line.str()), 0, {}});
+	}
+	{
+		std::unique_lock lock(mutex);
+		std::move(requests.begin(), requests.end(), std::back_inserter(pending));
+		work_available.notify_all();
+		batch_finished.wait(lock, [&] {
+			return batch.remaining == 0;
+		});
+	}
+	if (batch.failure != nullptr)
+		std::rethrow_exception(batch.failure);
+	timed_out = batch.timed_out;
+	std::vector<rating_type> result;
+	result.reserve(specimens.size());
+	for (auto&& rating : batch.ratings) {
+		result.push_back(std::move(*rating));
+	}
+	return result;
+}
+
+template<class Specimen, class Rating>
+inline std::size_t process_evaluator<Specimen, Rating>::pool_type::restarts() const {
+	std::lock_guard lock(mutex);
+	return restart_count;
+}
+
+template<class Specimen, class Rating>
+inline std::size_t process_evaluator<Specimen, Rating>::pool_type::timeouts() const {
+	std::lock_guard lock(mutex);
+	return timeout_count;
+}
+
+/// Sends pending requests to \a worker, starting it again first if it has exited
+template<class Specimen, class Rating>
+inline void process_evaluator<Specimen, Rating>::pool_type::write(worker_type& worker) {
+	std::unique_lock lock(mutex);
+	while (true) {
+		work_available.wait(lock, [&] {
+			return stopping || (!worker.killed && !pending.empty() && worker.in_flight.size() < depth);
+		});
+		if (stopping)
+			return;
+		if (worker.process == nullptr) {
+			lock.unlock();
+			std::shared_ptr<child_process> process;
+			std::exception_ptr failure;
+			try {
+				process = std::make_shared<child_process>(command);
+			} catch (...) {
+				failure = std::current_exception();
+			}
+			lock.lock();
+			if (failure != nullptr) {
+				if (!pending.empty()) {
+					fail(pending.front().second, failure);
+					pending.pop_front();
+				}
+				continue;
+			}
+			worker.process = std::move(process);
+			work_available.notify_all();
+			if (stopping)
+				worker.process->kill();
+			continue;
+		}
+		auto [id, request] = std::move(pending.front());
+		pending.pop_front();
+		const std::shared_ptr<const std::string> line = request.line;
+		request.sent = std::chrono::steady_clock::now();
+		worker.in_flight.emplace(id, std::move(request));
+		request_sent.notify_one();
+		const std::shared_ptr<child_process> process = worker.process;
+		lock.unlock();
+		const bool written = process->write(line->data(), line->size());
+		lock.lock();
+		if (!written) {
+			work_available.wait(lock, [&] {
+				return stopping || worker.process != process;
+			});
+		}
+	}
+}
+
+/// Collects the answers of \a worker, and notices when it exits
+template<class Specimen, class Rating>
+inline void process_evaluator<Specimen, Rating>::pool_type::read(worker_type& worker) {
+	std::string buffer;
+	char chunk[4096];
+	std::unique_lock lock(mutex);
+	while (true) {
+		work_available.wait(lock, [&] {
+			return stopping || worker.process != nullptr;
+		});
+		if (stopping)
+			return;
+		const std::shared_ptr<child_process> process = worker.process;
+		lock.unlock();
+		const std::size_t count = process->read(chunk, sizeof(chunk));
+		lock.lock();
+		if (count == 0) {
+			if (stopping)
+				return;
+			restart(worker);
+			buffer.clear();
+			continue;
+		}
+		buffer.append(chunk, count);
+		std::size_t first = 0;
+		for (std::size_t last = buffer.find('\n'); last != std::string::npos; last = buffer.find('\n', first)) {
+			answer(worker, buffer.substr(first, last - first));
+			first = last + 1;
+		}
+		buffer.erase(0, first);
+	}
+}
+
+/// Hands the unanswered requests of an exited worker to the others, and lets it be started again when needed
+template<class Specimen, class Rating>
+inline void process_evaluator<Specimen, Rating>::pool_type::restart(worker_type& worker) {
+	worker.process->kill();
+	worker.process = nullptr;
+	worker.killed = false;
+	restart_count++;
+	for (auto&& [id, request] : worker.in_flight) {
+		if (++request.attempts < max_attempts)
+			pending.emplace_front(id, std::move(request));
+		else
+			fail(request, std::make_exception_ptr(std::runtime_error("evaluation worker exited " + std::to_string(max_attempts) + " times without answering")));
+	}
+	worker.in_flight.clear();
+	work_available.notify_all();
+}
+
+/// Waits for the oldest request in flight to time out, and expires the requests of every worker then
+/**
+Runs on a thread of its own, so that a writer blocked on the input of a
+hung worker cannot delay the timeout.
+*/
+template<class Specimen, class Rating>
+inline void process_evaluator<Specimen, Rating>::pool_type::watch() {
+	std::unique_lock lock(mutex);
+	while (true) {
+		std::optional<std::chrono::steady_clock::time_point> oldest;
+		for (const worker_type& worker : workers) {
+			for (const auto& [id, request] : worker.in_flight) {
+				if (!oldest.has_value() || request.sent < *oldest)
+					oldest = request.sent;
+			}
+		}
+		if (oldest.has_value())
+			request_sent.wait_until(lock, *oldest + timeout);
+		else
+			request_sent.wait(lock);
+		if (stopping)
+			return;
+		const auto now = std::chrono::steady_clock::now();
+		for (worker_type& worker : workers) {
+			expire(worker, now);
+		}
+	}
+}
+
+/// Rates the requests of \a worker that are past their timeout, and if there are any kills it
+/**
+Its other requests are handed to the workers again right away, without
+counting as an attempt, since they only waited behind a hung one. No
+more are sent to it until its reader sees it exit and restarts it.
+*/
+template<class Specimen, class Rating>
+inline void process_evaluator<Specimen, Rating>::pool_type::expire(worker_type& worker, std::chrono::steady_clock::time_point now) {
+	if (worker.process == nullptr)
+		return;
+	bool expired = false;
+	for (auto request = worker.in_flight.begin(); request != worker.in_flight.end();) {
+		if (now - request->second.sent < timeout) {
+			++request;
+			continue;
+		}
+		request->second.batch->ratings[request->second.index].emplace(*timeout_rating);
+		request->second.batch->timed_out++;
+		settle(*request->second.batch);
+		request = worker.in_flight.erase(request);
+		timeout_count++;
+		expired = true;
+	}
+	if (!expired)
+		return;
+	for (auto&& [id, request] : worker.in_flight) {
+		pending.emplace_front(id, std::move(request));
+	}
+	worker.in_flight.clear();
+	worker.killed = true;
+	worker.process->kill();
+	work_available.notify_all();
+}
+
+template<class Specimen, class Rating>
+inline void process_evaluator<Specimen, Rating>::pool_type::answer(worker_type& worker, const std::string& line) {
+	std::istringstream in(line);
+	std::uint64_t id;
+	rating_type rating;
+	if (!(in >> id >> rating))
+		return;
+	const auto request = worker.in_flight.find(id);
+	if (request == worker.in_flight.end())
+		return;
+	request->second.batch->ratings[request->second.index].emplace(std::move(rating));
+	settle(*request->second.batch);
+	worker.in_flight.erase(request);
+	work_available.notify_all();
+}
+
+template<class Specimen, class Rating>
+inline void process_evaluator<Specimen, Rating>::pool_type::fail(const request_type& request, std::exception_ptr failure) {
+	if (request.batch->failure == nullptr)
+		request.batch->failure = std::move(failure);
+	settle(*request.batch);
+}
+
+template<class Specimen, class Rating>
+inline void process_evaluator<Specimen, Rating>::pool_type::settle(batch_type& batch) {
+	if (--batch.remaining == 0)
+		batch_finished.notify_all();
+}
+
+#endif
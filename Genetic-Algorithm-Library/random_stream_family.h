@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_RANDOM_STREAM_FAMILY_H
+#define GENETIC_ALGORITHM_LIBRARY_RANDOM_STREAM_FAMILY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <gsl/gsl_assert>
+#include "repeat.h"
+#include "xoshiro256_star_star.h"
+
+template<class Engine, class = void>
+struct has_jump : std::false_type {};
+
+template<class Engine>
+struct has_jump<Engine, std::void_t<decltype(std::declval<Engine&>().jump())>> : std::true_type {};
+
+/// Independent random engines identified by stream numbers and derived from a single master seed
+/**
+Give every worker its own engine, obtained by value from its stream
+number, instead of sharing a \c thread_safe_random_bit_generator. A run
+with a fixed master seed and a fixed assignment of work to streams is
+then reproducible regardless of thread scheduling.
+
+For engines that provide \c jump(), stream \a i is the engine seeded with
+the master seed and jumped \a i times, which guarantees that the streams
+do not overlap; stream numbers are meant to be small, such as worker
+indices. Other engines are seeded from a \c std::seed_seq of the master
+seed and the stream number.
+*/
+template<class Engine = xoshiro256_star_star>
+class random_stream_family {
+public:
+	using engine_type = Engine;
+	explicit random_stream_family(std::uint64_t master_seed) noexcept;
+	std::uint64_t seed() const noexcept;
+	engine_type operator()(std::size_t stream) const;
+private:
+	std::uint64_t master;
+};
+
+template<class Engine>
+inline random_stream_family<Engine>::random_stream_family(std::uint64_t master_seed) noexcept
+	: master(master_seed) {}
+
+template<class Engine>
+inline std::uint64_t random_stream_family<Engine>::seed() const noexcept {
+	return master;
+}
+
+template<class Engine>
+inline auto random_stream_family<Engine>::operator()(std::size_t stream) const -> engine_type {
+	if constexpr (has_jump<engine_type>::value) {
+		engine_type result(master);
+		repeat(stream, [&] {
+			result.jump();
+		});
+		return result;
+	} else {
+		const std::uint64_t id = stream;
+		std::seed_seq sequence {
+			static_cast<std::uint32_t>(master),
+			static_cast<std::uint32_t>(master >> 32),
+			static_cast<std::uint32_t>(id),
+			static_cast<std::uint32_t>(id >> 32),
+		};
+		return engine_type(sequence);
+	}
+}
+
+/// Generator forwarding to the engine that the calling thread has bound for its current task
+/**
+Operators built once but called concurrently, such as mutators run under
+a parallel \c batch_mutation, hold a reference to this generator instead
+of a \c thread_safe_random_bit_generator. Whoever runs a task binds an
+engine seeded for that task, so what the task draws does not depend on
+which thread runs it or on what that thread ran before. Calling it with
+no engine bound is an error.
+*/
+template<class Engine = xoshiro256_star_star>
+class task_random_bit_generator {
+public:
+	using engine_type = Engine;
+	using result_type = typename engine_type::result_type;
+	class binding;
+	static constexpr result_type min() noexcept(noexcept(engine_type::min()));
+	static constexpr result_type max() noexcept(noexcept(engine_type::max()));
+	result_type operator()();
+private:
+	static engine_type*& current() noexcept;
+};
+
+/// Binds an engine to the calling thread for the lifetime of the object
+template<class Engine>
+class task_random_bit_generator<Engine>::binding {
+public:
+	explicit binding(engine_type& engine) noexcept;
+	binding(const binding&) = delete;
+	binding& operator=(const binding&) = delete;
+	~binding();
+private:
+	engine_type* previous;
+};
+
+template<class Engine>
+inline task_random_bit_generator<Engine>::binding::binding(engine_type& engine) noexcept
+	: previous(std::exchange(current(), &engine)) {}
+
+template<class Engine>
+inline task_random_bit_generator<Engine>::binding::~binding() {
+	current() = previous;
+}
+
+template<class Engine>
+constexpr auto task_random_bit_generator<Engine>::min() noexcept(noexcept(engine_type::min())) -> result_type {
+	return engine_type::min();
+}
+
+template<class Engine>
+constexpr auto task_random_bit_generator<Engine>::max() noexcept(noexcept(engine_type::max())) -> result_type {
+	return engine_type::max();
+}
+
+template<class Engine>
+inline auto task_random_bit_generator<Engine>::operator()() -> result_type {
+	engine_type* const engine = current();
+	Expects(engine != nullptr);
+	return (*engine)();
+}
+
+template<class Engine>
+inline auto task_random_bit_generator<Engine>::current() noexcept -> engine_type*& {
+	static thread_local engine_type* engine = nullptr;
+	return engine;
+}
+
+#endif
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_REPLICATE_SELECTED_H
+#define GENETIC_ALGORITHM_LIBRARY_REPLICATE_SELECTED_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include "repeat.h"
+
+/// Keeps exactly \a n specimens, each one as many times as it was selected.
+/**
+Selected specimens are moved to the front of the vector and copied into
+the slots of the ones that were not selected, so no storage is allocated.
+The counts are reordered along with the specimens.
+
+@param[in,out] specimens The population to shrink to \a n specimens
+@param[in,out] counts    Number of times each specimen was selected; the
+                         counts must add up to \a n
+@param[in]     n         Number of specimens to keep
+*/
+template<class Specimen, class Allocator, class Count, class CountAllocator>
+void replicate_selected(std::vector<Specimen, Allocator>& specimens, std::vector<Count, CountAllocator>& counts, std::size_t n) {
+	Expects(counts.size() == specimens.size());
+	Expects(specimens.size() >= n);
+	std::size_t first = 0;
+	std::size_t last = specimens.size();
+	while (true) {
+		while (first < last && counts[first] > 0) {
+			first++;
+		}
+		while (first < last && counts[last - 1] == 0) {
+			last--;
+		}
+		if (first == last)
+			break;
+		std::swap(specimens[first], specimens[last - 1]);
+		std::swap(counts[first], counts[last - 1]);
+	}
+	std::size_t slot = first;
+	for (std::size_t i = 0; i < first; i++) {
+		repeat(counts[i] - 1, [&] {
+			Expects(slot < n);
+			specimens[slot++] = specimens[i];
+		});
+	}
+	Ensures(slot == n);
+	specimens.resize(n);
+}
+
+#endif
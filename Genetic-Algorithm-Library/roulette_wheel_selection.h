@@ -25,25 +25,37 @@
 #ifndef GENETIC_ALGORITHM_LIBRARY_ROULETTE_WHEEL_SELECTION_H
 #define GENETIC_ALGORITHM_LIBRARY_ROULETTE_WHEEL_SELECTION_H
 
-#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <limits>
-#include <random>
+#include <memory_resource>
 #include <utility>
 #include <type_traits>
 #include <vector>
-#include <gsl/gsl_assert>
+#include "bounded_selection.h"
+#include "bulk_distribution.h"
 #include "identity.h"
+#include "indexed_selection.h"
+#include "selection_holder.h"
 
 template<class UniformRandomBitGenerator, class Function = identity>
 class roulette_wheel_selection {
 public:
 	explicit roulette_wheel_selection(UniformRandomBitGenerator& g, const Function& f = Function()) noexcept(noexcept(Function(f)));
-	template<class Specimen>
-	void operator()(std::vector<Specimen>& specimens, std::size_t n);
+	template<class Specimen, class Allocator>
+	void operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n);
+	template<class Specimen, class Allocator>
+	void operator()(std::vector<Specimen, Allocator>& kept, std::size_t n, Specimen&& candidate);
 private:
+	template<class Rating>
+	using sample_type = std::common_type_t<double, std::invoke_result_t<Function&, const Rating&>>;
+	template<class Rating>
+	sample_type<Rating> sample(const Rating& rating);
 	UniformRandomBitGenerator& rand;
 	Function probability_function;
+	bulk_exponential_distribution distribution;
+	selection_holder<indexed_selection> scratch;
+	selection_holder<bounded_selection> stream;
 };
 
 template<class UniformRandomBitGenerator, class Function>
@@ -51,30 +63,29 @@ inline roulette_wheel_selection<UniformRandomBitGenerator, Function>::roulette_w
 	: rand(g), probability_function(f) {}
 
 template<class UniformRandomBitGenerator, class Function>
-template<class Specimen>
-inline void roulette_wheel_selection<UniformRandomBitGenerator, Function>::operator()(std::vector<Specimen>& specimens, std::size_t n) {
-	Expects(specimens.size() >= n);
-	using sample_type = std::common_type_t<double, decltype(probability_function(std::declval<typename Specimen::rating_type>()))>;
-	using iterator_type = typename std::vector<Specimen>::iterator;
-	using pair_type = std::pair<sample_type, iterator_type>;
-	std::vector<pair_type> samples;
-	samples.reserve(specimens.size());
-	for (iterator_type it = specimens.begin(); it != specimens.end(); ++it) {
-		const sample_type probability = probability_function(it->rating());
-		sample_type sample = std::numeric_limits<sample_type>::max();
-		if (probability > 0.0) {
-			const std::exponential_distribution<sample_type> distribution(probability);
-			sample = distribution(rand);
-		}
-		samples.emplace_back(sample, it);
-	}
-	std::nth_element(samples.begin(), samples.begin() + n, samples.end());
-	samples.resize(n);
-	iterator_type it = specimens.begin();
-	for (const auto& sample : samples) {
-		std::iter_swap(it++, sample.second);
-	}
-	specimens.resize(n);
+template<class Specimen, class Allocator>
+inline void roulette_wheel_selection<UniformRandomBitGenerator, Function>::operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n) {
+	using key_type = sample_type<typename Specimen::rating_type>;
+	scratch.get<key_type>()(specimens, n, [this](const Specimen& specimen) {
+		return sample(specimen.rating());
+	}, std::less<>());
+}
+
+template<class UniformRandomBitGenerator, class Function>
+template<class Specimen, class Allocator>
+inline void roulette_wheel_selection<UniformRandomBitGenerator, Function>::operator()(std::vector<Specimen, Allocator>& kept, std::size_t n, Specimen&& candidate) {
+	using key_type = sample_type<typename Specimen::rating_type>;
+	const key_type key = sample(candidate.rating());
+	stream.get<key_type>()(kept, n, std::move(candidate), key, std::less<>());
+}
+
+template<class UniformRandomBitGenerator, class Function>
+template<class Rating>
+inline auto roulette_wheel_selection<UniformRandomBitGenerator, Function>::sample(const Rating& rating) -> sample_type<Rating> {
+	const sample_type<Rating> probability = probability_function(rating);
+	if (probability > 0.0)
+		return distribution(rand) / probability;
+	return std::numeric_limits<sample_type<Rating>>::max();
 }
 
 #endif
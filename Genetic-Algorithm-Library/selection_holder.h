@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_SELECTION_HOLDER_H
+#define GENETIC_ALGORITHM_LIBRARY_SELECTION_HOLDER_H
+
+#include <any>
+#include <memory_resource>
+
+/// Owns the \a Selection state of a selector, whatever its key type
+/**
+A selector only learns the key type, such as the rating type, when it is
+first called, so it keeps its \c indexed_selection or
+\c bounded_selection here, created on first use from the ordinary heap.
+Copies start with no state, so every copy of a selector can follow a
+population of its own, but a single selector must not be used for two
+populations at once.
+
+@tparam Selection Class template of the state, taking the key type
+*/
+template<template<class> class Selection>
+class selection_holder {
+public:
+	selection_holder() = default;
+	selection_holder(const selection_holder&) noexcept;
+	selection_holder& operator=(const selection_holder&) noexcept;
+	template<class Key>
+	Selection<Key>& get();
+private:
+	std::any selection;
+};
+
+template<template<class> class Selection>
+inline selection_holder<Selection>::selection_holder(const selection_holder&) noexcept {}
+
+template<template<class> class Selection>
+inline auto selection_holder<Selection>::operator=(const selection_holder&) noexcept -> selection_holder& {
+	return *this;
+}
+
+template<template<class> class Selection>
+template<class Key>
+inline Selection<Key>& selection_holder<Selection>::get() {
+	if (const auto result = std::any_cast<Selection<Key>>(&selection))
+		return *result;
+	return selection.emplace<Selection<Key>>(std::pmr::new_delete_resource());
+}
+
+#endif
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_STOCHASTIC_UNIVERSAL_SAMPLING_H
+#define GENETIC_ALGORITHM_LIBRARY_STOCHASTIC_UNIVERSAL_SAMPLING_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <random>
+#include <vector>
+#include <gsl/gsl_assert>
+#include "identity.h"
+#include "replicate_selected.h"
+
+/// Fitness proportionate selection with a single spin of an \a n pointer wheel
+template<class UniformRandomBitGenerator, class Function = identity>
+class stochastic_universal_sampling {
+public:
+	explicit stochastic_universal_sampling(UniformRandomBitGenerator& g, const Function& f = Function()) noexcept(noexcept(Function(f)));
+	template<class Specimen, class Allocator>
+	void operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n);
+private:
+	UniformRandomBitGenerator& rand;
+	Function probability_function;
+	std::pmr::vector<double> weights;
+	std::pmr::vector<std::size_t> counts;
+};
+
+template<class UniformRandomBitGenerator, class Function>
+inline stochastic_universal_sampling<UniformRandomBitGenerator, Function>::stochastic_universal_sampling(UniformRandomBitGenerator& g, const Function& f) noexcept(noexcept(Function(f)))
+	: rand(g), probability_function(f) {}
+
+template<class UniformRandomBitGenerator, class Function>
+template<class Specimen, class Allocator>
+inline void stochastic_universal_sampling<UniformRandomBitGenerator, Function>::operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n) {
+	Expects(specimens.size() >= n);
+	if (n == 0) {
+		specimens.clear();
+		return;
+	}
+	weights.clear();
+	double total = 0.0;
+	for (const auto& specimen : specimens) {
+		const double weight = std::max(0.0, static_cast<double>(probability_function(specimen.rating())));
+		weights.push_back(weight);
+		total += weight;
+	}
+	if (!(total > 0.0)) {
+		std::fill(weights.begin(), weights.end(), 1.0);
+		total = static_cast<double>(weights.size());
+	}
+	counts.assign(specimens.size(), 0);
+	const double step = total / static_cast<double>(n);
+	double pointer = std::uniform_real_distribution<double>(0.0, step)(rand);
+	double cumulative = 0.0;
+	std::size_t selected = 0;
+	for (std::size_t i = 0; i < weights.size(); i++) {
+		cumulative += weights[i];
+		for (; selected < n && pointer < cumulative; selected++) {
+			counts[i]++;
+			pointer += step;
+		}
+	}
+	if (selected < n) {
+		const auto last = std::find_if(weights.rbegin(), weights.rend(), [](double weight) {
+			return weight > 0.0;
+		});
+		counts[std::distance(last, weights.rend()) - 1] += n - selected;
+	}
+	replicate_selected(specimens, counts, n);
+}
+
+#endif
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_SURROGATE_SCREENING_H
+#define GENETIC_ALGORITHM_LIBRARY_SURROGATE_SCREENING_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <vector>
+#include <gsl/gsl_assert>
+
+/// Evaluates only the offspring a surrogate model predicts to be the most promising.
+/**
+Until the model is ready every specimen is evaluated. Afterwards the
+predicted best \a fraction of the specimens, under \a comp, are evaluated
+and the rest are given their predicted rating, marked as approximate.
+Every exact rating is fed back to the model.
+
+@tparam Model    Surrogate such as \c nearest_neighbor_surrogate or \c linear_surrogate
+@tparam Function Function computing the model features of a specimen
+*/
+template<class Model, class Function, class Compare = std::less<>>
+class surrogate_screening {
+public:
+	surrogate_screening(const Model& model, const Function& features, double fraction, const Compare& comp = Compare());
+	template<class Specimen, class Allocator, class Evaluator>
+	void operator()(std::vector<Specimen, Allocator>& specimens, Evaluator&& evaluator);
+private:
+	template<class Specimen, class Evaluator>
+	void evaluate(Specimen& specimen, Evaluator& evaluator);
+	Model model;
+	Function features;
+	double fraction;
+	Compare comparator;
+	std::pmr::vector<double> predictions;
+	std::pmr::vector<std::size_t> order;
+};
+
+template<class Model, class Function, class Compare>
+inline surrogate_screening<Model, Function, Compare>::surrogate_screening(const Model& model, const Function& features, double fraction, const Compare& comp)
+	: model(model), features(features), fraction(fraction), comparator(comp) {
+	Expects(fraction > 0.0 && fraction <= 1.0);
+}
+
+template<class Model, class Function, class Compare>
+template<class Specimen, class Allocator, class Evaluator>
+inline void surrogate_screening<Model, Function, Compare>::operator()(std::vector<Specimen, Allocator>& specimens, Evaluator&& evaluator) {
+	using rating_type = typename Specimen::rating_type;
+	if (!model.ready()) {
+		for (auto&& specimen : specimens) {
+			evaluate(specimen, evaluator);
+		}
+		return;
+	}
+	const std::size_t size = specimens.size();
+	const std::size_t exact = std::min(size, static_cast<std::size_t>(std::ceil(fraction * size)));
+	predictions.clear();
+	order.clear();
+	for (std::size_t i = 0; i < size; i++) {
+		predictions.push_back(model.predict(features(specimens[i].value())));
+		order.push_back(i);
+	}
+	std::nth_element(order.begin(), order.begin() + exact, order.end(), [&](std::size_t lhs, std::size_t rhs) {
+		return comparator(static_cast<rating_type>(predictions[rhs]), static_cast<rating_type>(predictions[lhs]));
+	});
+	for (std::size_t i = 0; i < size; i++) {
+		const std::size_t index = order[i];
+		if (i < exact)
+			evaluate(specimens[index], evaluator);
+		else
+			specimens[index].estimate(static_cast<rating_type>(predictions[index]));
+	}
+}
+
+template<class Model, class Function, class Compare>
+template<class Specimen, class Evaluator>
+inline void surrogate_screening<Model, Function, Compare>::evaluate(Specimen& specimen, Evaluator& evaluator) {
+	specimen.evaluate(evaluator);
+	model.learn(features(specimen.value()), static_cast<double>(specimen.rating()));
+}
+
+#endif
@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_TELEMETRY_LOGGER_H
+#define GENETIC_ALGORITHM_LIBRARY_TELEMETRY_LOGGER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <gsl/gsl_util>
+#include "counting_resource.h"
+#ifdef __linux__
+#include <fstream>
+#include <unistd.h>
+#endif
+
+/// Observer keeping live figures of a run for other threads to read, for example through a \c telemetry_server.
+/**
+The figures are atomics written by the thread running the algorithm
+alone, so observing costs no locks and \c write_metrics may be called
+from any thread at any time. The best and the mean rating are only kept
+for ratings convertible to \c double, with \a comparator telling which
+rating is worse, as in the context of the algorithm. Evaluations are
+counted by evaluators wrapped with \c count_evaluations, and memory in
+use by \a resource, when given.
+
+\c write_metrics uses the Prometheus text format. Seeing
+\c ga_seconds_since_progress grow tells a stalled run apart from a slow
+one.
+*/
+template<class Compare>
+class telemetry_logger {
+public:
+	explicit telemetry_logger(const Compare& comparator = Compare(), const counting_resource* resource = nullptr);
+	telemetry_logger(const telemetry_logger&) = delete;
+	telemetry_logger& operator=(const telemetry_logger&) = delete;
+	template<class Evaluator>
+	auto count_evaluations(Evaluator evaluator);
+	template<class Algorithm>
+	void enter(const Algorithm&, typename Algorithm::phase_type phase) noexcept;
+	template<class Algorithm>
+	void leave(const Algorithm&, typename Algorithm::phase_type phase) noexcept;
+	template<class Algorithm>
+	void timeouts(const Algorithm&, std::size_t count) noexcept;
+	template<class Algorithm>
+	void operator()(const Algorithm&, typename Algorithm::stage_type stage, const typename Algorithm::population_type& specimens);
+	template<class CharT, class Traits>
+	void write_metrics(std::basic_ostream<CharT, Traits>& out) const;
+private:
+	using clock_type = std::chrono::steady_clock;
+	// in the order of genetic_algorithm::phase_type
+	static constexpr std::array<const char*, 4> phase_names {{"generate", "evaluate", "select", "breed"}};
+	static void add(std::atomic<double>& value, double increment) noexcept;
+	Compare comparator;
+	const counting_resource* resource;
+	clock_type::time_point phase_start;
+	clock_type::time_point generation_start;
+	std::uint64_t generation_evaluations = 0;
+	std::atomic<std::uint64_t> runs {0};
+	std::atomic<std::uint64_t> generation {0};
+	std::atomic<double> best_rating {0};
+	std::atomic<double> mean_rating {0};
+	std::atomic<std::uint64_t> evaluations {0};
+	std::atomic<double> evaluation_rate {0};
+	std::atomic<std::size_t> timed_out {0};
+	std::atomic<double> generation_seconds {0};
+	std::array<std::atomic<double>, phase_names.size()> phase_seconds {};
+	std::atomic<clock_type::rep> progress_time;
+};
+
+template<class Compare>
+inline telemetry_logger<Compare>::telemetry_logger(const Compare& comparator, const counting_resource* resource)
+	: comparator(comparator), resource(resource), progress_time(clock_type::now().time_since_epoch().count()) {}
+
+/// Wraps \a evaluator to count its calls; the wrapper may be called concurrently.
+template<class Compare>
+template<class Evaluator>
+inline auto telemetry_logger<Compare>::count_evaluations(Evaluator evaluator) {
+	return [counter = &evaluations, evaluator = std::move(evaluator)](auto&&... args) mutable -> decltype(auto) {
+		counter->fetch_add(1, std::memory_order_relaxed);
+		return evaluator(std::forward<decltype(args)>(args)...);
+	};
+}
+
+template<class Compare>
+template<class Algorithm>
+inline void telemetry_logger<Compare>::enter(const Algorithm&, typename Algorithm::phase_type) noexcept {
+	phase_start = clock_type::now();
+}
+
+template<class Compare>
+template<class Algorithm>
+inline void telemetry_logger<Compare>::leave(const Algorithm&, typename Algorithm::phase_type phase) noexcept {
+	const std::chrono::duration<double> elapsed = clock_type::now() - phase_start;
+	add(gsl::at(phase_seconds, static_cast<std::size_t>(phase)), elapsed.count());
+}
+
+template<class Compare>
+template<class Algorithm>
+inline void telemetry_logger<Compare>::timeouts(const Algorithm&, std::size_t count) noexcept {
+	timed_out.store(count, std::memory_order_relaxed);
+}
+
+template<class Compare>
+template<class Algorithm>
+inline void telemetry_logger<Compare>::operator()(const Algorithm&, typename Algorithm::stage_type stage, const typename Algorithm::population_type& specimens) {
+	using stage_type = typename Algorithm::stage_type;
+	using rating_type = typename Algorithm::rating_type;
+	if (stage == stage_type::selected)
+		return;
+	const clock_type::time_point now = clock_type::now();
+	const std::uint64_t evaluated = evaluations.load(std::memory_order_relaxed);
+	if (stage == stage_type::generated) {
+		runs.fetch_add(1, std::memory_order_relaxed);
+		generation.store(0, std::memory_order_relaxed);
+	} else {
+		const std::chrono::duration<double> elapsed = now - generation_start;
+		generation.fetch_add(1, std::memory_order_relaxed);
+		generation_seconds.store(elapsed.count(), std::memory_order_relaxed);
+		if (elapsed.count() > 0)
+			evaluation_rate.store((evaluated - generation_evaluations) / elapsed.count(), std::memory_order_relaxed);
+	}
+	generation_start = now;
+	generation_evaluations = evaluated;
+	if constexpr (std::is_convertible_v<rating_type, double>) {
+		if (!specimens.empty()) {
+			const auto best = std::max_element(specimens.begin(), specimens.end(), [this](const auto& lhs, const auto& rhs) {
+				return comparator(lhs.rating(), rhs.rating());
+			});
+			double sum = 0;
+			for (const auto& specimen : specimens) {
+				sum += static_cast<double>(specimen.rating());
+			}
+			best_rating.store(static_cast<double>(best->rating()), std::memory_order_relaxed);
+			mean_rating.store(sum / specimens.size(), std::memory_order_relaxed);
+		}
+	}
+	progress_time.store(now.time_since_epoch().count(), std::memory_order_release);
+}
+
+template<class Compare>
+template<class CharT, class Traits>
+inline void telemetry_logger<Compare>::write_metrics(std::basic_ostream<CharT, Traits>& out) const {
+	const auto precision = out.precision(std::numeric_limits<double>::digits10);
+	const auto metric = [&](const char* name, const char* type, const char* help) {
+		out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+	};
+	const std::chrono::duration<double> since_progress = clock_type::now() - clock_type::time_point(clock_type::duration(progress_time.load(std::memory_order_acquire)));
+	metric("ga_runs_total", "counter", "Runs of the algorithm started.");
+	out << "ga_runs_total " << runs.load(std::memory_order_relaxed) << '\n';
+	metric("ga_generation", "gauge", "Generations bred in the current run.");
+	out << "ga_generation " << generation.load(std::memory_order_relaxed) << '\n';
+	metric("ga_best_rating", "gauge", "Best rating in the latest population.");
+	out << "ga_best_rating " << best_rating.load(std::memory_order_relaxed) << '\n';
+	metric("ga_mean_rating", "gauge", "Mean rating of the latest population.");
+	out << "ga_mean_rating " << mean_rating.load(std::memory_order_relaxed) << '\n';
+	metric("ga_evaluations_total", "counter", "Calls of the counted evaluators.");
+	out << "ga_evaluations_total " << evaluations.load(std::memory_order_relaxed) << '\n';
+	metric("ga_evaluations_per_second", "gauge", "Evaluations per second during the latest generation.");
+	out << "ga_evaluations_per_second " << evaluation_rate.load(std::memory_order_relaxed) << '\n';
+	metric("ga_evaluation_timeouts", "gauge", "Evaluations of the current run that missed their deadline.");
+	out << "ga_evaluation_timeouts " << timed_out.load(std::memory_order_relaxed) << '\n';
+	metric("ga_generation_duration_seconds", "gauge", "Duration of the latest generation.");
+	out << "ga_generation_duration_seconds " << generation_seconds.load(std::memory_order_relaxed) << '\n';
+	metric("ga_phase_seconds_total", "counter", "Time spent in every phase of the algorithm.");
+	for (std::size_t i = 0; i < phase_names.size(); i++) {
+		out << "ga_phase_seconds_total{phase=\"" << phase_names[i] << "\"} " << phase_seconds[i].load(std::memory_order_relaxed) << '\n';
+	}
+	metric("ga_seconds_since_progress", "gauge", "Time since the latest population was reported.");
+	out << "ga_seconds_since_progress " << since_progress.count() << '\n';
+	if (resource != nullptr) {
+		const counting_resource::statistics_type statistics = resource->statistics();
+		metric("ga_memory_in_use_bytes", "gauge", "Bytes allocated through the counting resource and not yet released.");
+		out << "ga_memory_in_use_bytes " << statistics.bytes_allocated - statistics.bytes_deallocated << '\n';
+	}
+#ifdef __linux__
+	std::ifstream statm("/proc/self/statm");
+	std::size_t size, resident;
+	if (statm >> size >> resident) {
+		metric("process_resident_memory_bytes", "gauge", "Resident memory size in bytes.");
+		out << "process_resident_memory_bytes " << resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) << '\n';
+	}
+#endif
+	out.precision(precision);
+}
+
+template<class Compare>
+inline void telemetry_logger<Compare>::add(std::atomic<double>& value, double increment) noexcept {
+	value.store(value.load(std::memory_order_relaxed) + increment, std::memory_order_relaxed);
+}
+
+#endif
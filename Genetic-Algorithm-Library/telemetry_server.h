@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_TELEMETRY_SERVER_H
+#define GENETIC_ALGORITHM_LIBRARY_TELEMETRY_SERVER_H
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <gsl/gsl_assert>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <cerrno>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+/// Minimal HTTP server on the loopback interface answering <tt>GET /metrics</tt> from a thread of its own.
+/**
+Every request is answered with what \a write puts into a stream, as
+Prometheus text, so \a write is called from the server thread and has to
+be safe to call concurrently with the algorithm, as
+\c telemetry_logger::write_metrics is. Requests are served one at a
+time. Pass port 0 to have a free port picked, and ask \c port for it.
+*/
+class telemetry_server {
+public:
+	telemetry_server(std::uint16_t port, std::function<void(std::ostream&)> write);
+	telemetry_server(const telemetry_server&) = delete;
+	telemetry_server& operator=(const telemetry_server&) = delete;
+	~telemetry_server();
+	std::uint16_t port() const noexcept;
+private:
+#ifdef _WIN32
+	using socket_type = SOCKET;
+	static constexpr socket_type invalid_socket = INVALID_SOCKET;
+#else
+	using socket_type = int;
+	static constexpr socket_type invalid_socket = -1;
+#endif
+	static constexpr int poll_interval = 200;
+	static constexpr int request_timeout = 1000;
+	static constexpr std::size_t max_request_size = 8192;
+	static void startup();
+	static void cleanup() noexcept;
+	static int last_error() noexcept;
+	static void close_socket(socket_type socket) noexcept;
+	static bool readable(socket_type socket, int timeout) noexcept;
+	static bool send_all(socket_type socket, const std::string& data) noexcept;
+	void serve() noexcept;
+	void respond(socket_type client) const;
+	std::function<void(std::ostream&)> write;
+	socket_type listener;
+	std::uint16_t bound_port;
+	std::atomic<bool> stopping {false};
+	std::thread thread;
+};
+
+inline telemetry_server::telemetry_server(std::uint16_t port, std::function<void(std::ostream&)> write)
+	: write(std::move(write)) {
+	Expects(this->write != nullptr);
+	startup();
+	listener = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (listener == invalid_socket) {
+		const int error = last_error();
+		cleanup();
+		throw std::system_error(error, std::system_category(), "cannot create the telemetry socket");
+	}
+	const auto fail = [&](const char* what) {
+		const int error = last_error();
+		close_socket(listener);
+		cleanup();
+		throw std::system_error(error, std::system_category(), what);
+	};
+	const int reuse = 1;
+	::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+	sockaddr_in address {};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(port);
+	if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+		fail("cannot bind the telemetry socket");
+	if (::listen(listener, SOMAXCONN) != 0)
+		fail("cannot listen on the telemetry socket");
+	socklen_t length = sizeof(address);
+	if (::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+		fail("cannot inspect the telemetry socket");
+	bound_port = ntohs(address.sin_port);
+	thread = std::thread(&telemetry_server::serve, this);
+}
+
+inline telemetry_server::~telemetry_server() {
+	stopping = true;
+	thread.join();
+	close_socket(listener);
+	cleanup();
+}
+
+inline std::uint16_t telemetry_server::port() const noexcept {
+	return bound_port;
+}
+
+#ifdef _WIN32
+
+inline void telemetry_server::startup() {
+	WSADATA data;
+	if (const int error = WSAStartup(MAKEWORD(2, 2), &data))
+		throw std::system_error(error, std::system_category(), "cannot start Winsock");
+}
+
+inline void telemetry_server::cleanup() noexcept {
+	WSACleanup();
+}
+
+inline int telemetry_server::last_error() noexcept {
+	return WSAGetLastError();
+}
+
+inline void telemetry_server::close_socket(socket_type socket) noexcept {
+	::closesocket(socket);
+}
+
+inline bool telemetry_server::readable(socket_type socket, int timeout) noexcept {
+	WSAPOLLFD descriptor {socket, POLLIN, 0};
+	return WSAPoll(&descriptor, 1, timeout) > 0;
+}
+
+inline bool telemetry_server::send_all(socket_type socket, const std::string& data) noexcept {
+	for (std::size_t sent = 0; sent < data.size();) {
+		const int count = ::send(socket, data.data() + sent, int(std::min<std::size_t>(data.size() - sent, INT_MAX)), 0);
+		if (count <= 0)
+			return false;
+		sent += count;
+	}
+	return true;
+}
+
+#else
+
+inline void telemetry_server::startup() {}
+
+inline void telemetry_server::cleanup() noexcept {}
+
+inline int telemetry_server::last_error() noexcept {
+	return errno;
+}
+
+inline void telemetry_server::close_socket(socket_type socket) noexcept {
+	::close(socket);
+}
+
+inline bool telemetry_server::readable(socket_type socket, int timeout) noexcept {
+	pollfd descriptor {socket, POLLIN, 0};
+	return ::poll(&descriptor, 1, timeout) > 0;
+}
+
+inline bool telemetry_server::send_all(socket_type socket, const std::string& data) noexcept {
+#ifdef MSG_NOSIGNAL
+	constexpr int flags = MSG_NOSIGNAL;
+#else
+	constexpr int flags = 0;
+#endif
+	for (std::size_t sent = 0; sent < data.size();) {
+		const ssize_t count = ::send(socket, data.data() + sent, data.size() - sent, flags);
+		if (count <= 0)
+			return false;
+		sent += count;
+	}
+	return true;
+}
+
+#endif
+
+inline void telemetry_server::serve() noexcept {
+	while (!stopping) {
+		if (!readable(listener, poll_interval))
+			continue;
+		const socket_type client = ::accept(listener, nullptr, nullptr);
+		if (client == invalid_socket)
+			continue;
+		try {
+			respond(client);
+		} catch (...) {}
+		close_socket(client);
+	}
+}
+
+inline void telemetry_server::respond(socket_type client) const {
+	std::string request;
+	char buffer[1024];
+	while (request.find("\r\n\r\n") == std::string::npos) {
+		if (request.size() >= max_request_size || !readable(client, request_timeout))
+			return;
+		const auto count = ::recv(client, buffer, sizeof(buffer), 0);
+		if (count <= 0)
+			return;
+		request.append(buffer, count);
+	}
+	const auto starts_with = [&](const char* prefix) {
+		return request.compare(0, std::char_traits<char>::length(prefix), prefix) == 0;
+	};
+	std::string status = "200 OK";
+	std::ostringstream body;
+	if (starts_with("GET /metrics ") || starts_with("GET / ")) {
+		try {
+			write(body);
+		} catch (...) {
+			status = "500 Internal Server Error";
+			body.str({});
+		}
+	} else {
+		status = "404 Not Found";
+	}
+	const std::string content = body.str();
+	std::ostringstream response;
+	response << "HTTP/1.1 " << status << "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nContent-Length: " << content.size() << "\r\nConnection: close\r\n\r\n" << content;
+	send_all(client, response.str());
+}
+
+#endif
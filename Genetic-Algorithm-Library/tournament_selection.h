@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_TOURNAMENT_SELECTION_H
+#define GENETIC_ALGORITHM_LIBRARY_TOURNAMENT_SELECTION_H
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <random>
+#include <vector>
+#include <gsl/gsl_assert>
+#include "repeat.h"
+#include "replicate_selected.h"
+
+template<class UniformRandomBitGenerator, class Compare = std::less<>>
+class tournament_selection {
+public:
+	tournament_selection(UniformRandomBitGenerator& g, std::size_t k, const Compare& comp = Compare());
+	template<class Specimen, class Allocator>
+	void operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n);
+private:
+	UniformRandomBitGenerator& rand;
+	std::size_t tournament_size;
+	Compare comparator;
+	std::pmr::vector<std::size_t> counts;
+};
+
+template<class UniformRandomBitGenerator, class Compare>
+inline tournament_selection<UniformRandomBitGenerator, Compare>::tournament_selection(UniformRandomBitGenerator& g, std::size_t k, const Compare& comp)
+	: rand(g), tournament_size(k), comparator(comp) {
+	Expects(tournament_size > 0);
+}
+
+template<class UniformRandomBitGenerator, class Compare>
+template<class Specimen, class Allocator>
+inline void tournament_selection<UniformRandomBitGenerator, Compare>::operator()(std::vector<Specimen, Allocator>& specimens, std::size_t n) {
+	Expects(specimens.size() >= n);
+	if (n == 0) {
+		specimens.clear();
+		return;
+	}
+	counts.assign(specimens.size(), 0);
+	std::uniform_int_distribution<std::size_t> distribution(0, specimens.size() - 1);
+	repeat(n, [&] {
+		std::size_t winner = distribution(rand);
+		repeat(tournament_size - 1, [&] {
+			const std::size_t challenger = distribution(rand);
+			if (comparator(specimens[winner].rating(), specimens[challenger].rating()))
+				winner = challenger;
+		});
+		counts[winner]++;
+	});
+	replicate_selected(specimens, counts, n);
+}
+
+#endif
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_TRACE_LOGGER_H
+#define GENETIC_ALGORITHM_LIBRARY_TRACE_LOGGER_H
+
+#include <array>
+#include <cstddef>
+#include <gsl/gsl_util>
+#include "trace_recorder.h"
+
+/// Observer recording the phases of the algorithm as spans, and its stages as instants, in a \c trace_recorder.
+/**
+Together with the spans the library records on its own, this shows every
+generation on a timeline, with the evaluation workers and the waits for
+them next to the phases of the thread running the algorithm.
+*/
+class trace_logger {
+public:
+	explicit trace_logger(trace_recorder& recorder) noexcept;
+	template<class Algorithm>
+	void enter(const Algorithm&, typename Algorithm::phase_type phase) noexcept;
+	template<class Algorithm>
+	void leave(const Algorithm&, typename Algorithm::phase_type phase) noexcept;
+	template<class Algorithm>
+	void operator()(const Algorithm&, typename Algorithm::stage_type stage, const typename Algorithm::population_type&) noexcept;
+private:
+	// in the order of genetic_algorithm::phase_type and genetic_algorithm::stage_type
+	static constexpr std::array<const char*, 4> phase_names {{"generate", "evaluate", "select", "breed"}};
+	static constexpr std::array<const char*, 3> stage_names {{"generated", "selected", "bred"}};
+	trace_recorder& recorder;
+	trace_recorder::clock_type::time_point start;
+};
+
+inline trace_logger::trace_logger(trace_recorder& recorder) noexcept
+	: recorder(recorder) {}
+
+template<class Algorithm>
+inline void trace_logger::enter(const Algorithm&, typename Algorithm::phase_type) noexcept {
+	start = trace_recorder::clock_type::now();
+}
+
+template<class Algorithm>
+inline void trace_logger::leave(const Algorithm&, typename Algorithm::phase_type phase) noexcept {
+	recorder.record(gsl::at(phase_names, static_cast<std::size_t>(phase)), "phase", start, trace_recorder::clock_type::now());
+}
+
+template<class Algorithm>
+inline void trace_logger::operator()(const Algorithm&, typename Algorithm::stage_type stage, const typename Algorithm::population_type&) noexcept {
+	recorder.mark(gsl::at(stage_names, static_cast<std::size_t>(stage)), "stage", trace_recorder::clock_type::now());
+}
+
+#endif
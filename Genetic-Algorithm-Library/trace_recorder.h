@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_TRACE_RECORDER_H
+#define GENETIC_ALGORITHM_LIBRARY_TRACE_RECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include <gsl/gsl_assert>
+
+/// Timeline of spans recorded by many threads, written as Chrome trace events
+/**
+Every thread records into a buffer of its own, so recording takes no lock
+once a thread has recorded its first event. Each buffer keeps at most
+\a capacity events; later ones are dropped and counted by \c dropped.
+Names and categories are not copied and have to outlive the recorder,
+string literals being the usual choice.
+
+The library records spans through the recorder made current with
+\c install: evaluation workers, waits for them, specimen construction in
+a \c parallel_generator and the calls sampled by a \c traced_function.
+\c write produces a JSON file that Perfetto and \c chrome://tracing open;
+it must not run while other threads are still recording.
+*/
+class trace_recorder {
+public:
+	using clock_type = std::chrono::steady_clock;
+	explicit trace_recorder(std::size_t capacity = std::size_t(1) << 20);
+	trace_recorder(const trace_recorder&) = delete;
+	trace_recorder& operator=(const trace_recorder&) = delete;
+	static trace_recorder* install(trace_recorder* recorder) noexcept;
+	static trace_recorder* current() noexcept;
+	void record(const char* name, const char* category, clock_type::time_point start, clock_type::time_point finish) noexcept;
+	void mark(const char* name, const char* category, clock_type::time_point time) noexcept;
+	void name_thread(const char* name);
+	std::size_t dropped() const noexcept;
+	template<class CharT, class Traits>
+	void write(std::basic_ostream<CharT, Traits>& out) const;
+private:
+	struct event_type {
+		const char* name;
+		const char* category;
+		clock_type::duration start;
+		clock_type::duration duration;
+		bool instant;
+	};
+	struct buffer_type {
+		std::size_t thread;
+		const char* name = nullptr;
+		std::vector<event_type> events;
+	};
+	static std::atomic<trace_recorder*>& installed() noexcept;
+	static std::size_t thread_number() noexcept;
+	buffer_type& buffer();
+	void append(const event_type& event) noexcept;
+	template<class CharT, class Traits>
+	static void write_string(std::basic_ostream<CharT, Traits>& out, const char* text);
+	template<class CharT, class Traits>
+	static void write_microseconds(std::basic_ostream<CharT, Traits>& out, clock_type::duration duration);
+	const std::uint64_t id;
+	const std::size_t capacity;
+	const clock_type::time_point origin;
+	mutable std::mutex mutex;
+	std::deque<buffer_type> buffers;
+	std::atomic<std::size_t> dropped_events {0};
+};
+
+/// Span recorded by the current \c trace_recorder, if any, from construction to destruction
+class trace_span {
+public:
+	trace_span(const char* name, const char* category) noexcept;
+	trace_span(const trace_span&) = delete;
+	trace_span& operator=(const trace_span&) = delete;
+	~trace_span();
+private:
+	trace_recorder* recorder;
+	const char* name;
+	const char* category;
+	trace_recorder::clock_type::time_point start;
+};
+
+inline trace_recorder::trace_recorder(std::size_t capacity)
+	: id([] {
+		static std::atomic<std::uint64_t> next {1};
+		return next.fetch_add(1, std::memory_order_relaxed);
+	}()), capacity(capacity), origin(clock_type::now()) {
+	Expects(capacity > 0);
+}
+
+/// Makes \a recorder the one the library records into and returns the previous one
+/**
+Pass \c nullptr to stop recording; it has to be done before the
+recorder is destroyed.
+*/
+inline trace_recorder* trace_recorder::install(trace_recorder* recorder) noexcept {
+	return installed().exchange(recorder);
+}
+
+inline trace_recorder* trace_recorder::current() noexcept {
+	return installed().load(std::memory_order_acquire);
+}
+
+inline void trace_recorder::record(const char* name, const char* category, clock_type::time_point start, clock_type::time_point finish) noexcept {
+	append({name, category, start - origin, finish - start, false});
+}
+
+inline void trace_recorder::mark(const char* name, const char* category, clock_type::time_point time) noexcept {
+	append({name, category, time - origin, clock_type::duration::zero(), true});
+}
+
+/// Names the calling thread on the timeline
+inline void trace_recorder::name_thread(const char* name) {
+	buffer().name = name;
+}
+
+inline std::size_t trace_recorder::dropped() const noexcept {
+	return dropped_events.load(std::memory_order_relaxed);
+}
+
+template<class CharT, class Traits>
+inline void trace_recorder::write(std::basic_ostream<CharT, Traits>& out) const {
+	std::lock_guard lock(mutex);
+	out << "{\"traceEvents\":[";
+	const char* separator = "\n";
+	for (const buffer_type& buffer : buffers) {
+		if (buffer.name != nullptr) {
+			out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.thread << ",\"args\":{\"name\":";
+			write_string(out, buffer.name);
+			out << "}}";
+			separator = ",\n";
+		}
+		for (const event_type& event : buffer.events) {
+			out << separator << "{\"name\":";
+			write_string(out, event.name);
+			out << ",\"cat\":";
+			write_string(out, event.category);
+			if (event.instant) {
+				out << ",\"ph\":\"i\",\"s\":\"t\"";
+			} else {
+				out << ",\"ph\":\"X\",\"dur\":";
+				write_microseconds(out, event.duration);
+			}
+			out << ",\"ts\":";
+			write_microseconds(out, event.start);
+			out << ",\"pid\":1,\"tid\":" << buffer.thread << '}';
+			separator = ",\n";
+		}
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+inline std::atomic<trace_recorder*>& trace_recorder::installed() noexcept {
+	static std::atomic<trace_recorder*> recorder {nullptr};
+	return recorder;
+}
+
+/// Small number identifying the calling thread, in the order threads first ask for it
+inline std::size_t trace_recorder::thread_number() noexcept {
+	static std::atomic<std::size_t> next {0};
+	thread_local const std::size_t number = next.fetch_add(1, std::memory_order_relaxed);
+	return number;
+}
+
+inline auto trace_recorder::buffer() -> buffer_type& {
+	thread_local std::uint64_t cached_id = 0;
+	thread_local buffer_type* cached = nullptr;
+	if (cached_id != id) {
+		std::lock_guard lock(mutex);
+		buffers.emplace_back();
+		cached = &buffers.back();
+		cached->thread = thread_number();
+		cached_id = id;
+	}
+	return *cached;
+}
+
+inline void trace_recorder::append(const event_type& event) noexcept {
+	try {
+		std::vector<event_type>& events = buffer().events;
+		if (events.size() < capacity) {
+			events.push_back(event);
+			return;
+		}
+	} catch (...) {}
+	dropped_events.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<class CharT, class Traits>
+inline void trace_recorder::write_string(std::basic_ostream<CharT, Traits>& out, const char* text) {
+	out << '"';
+	for (; *text != '\0'; ++text) {
+		if (*text == '"' || *text == '\\')
+			out << '\\';
+		out << *text;
+	}
+	out << '"';
+}
+
+template<class CharT, class Traits>
+inline void trace_recorder::write_microseconds(std::basic_ostream<CharT, Traits>& out, clock_type::duration duration) {
+	const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+	out << nanoseconds / 1000 << '.' << char('0' + nanoseconds / 100 % 10) << char('0' + nanoseconds / 10 % 10) << char('0' + nanoseconds % 10);
+}
+
+inline trace_span::trace_span(const char* name, const char* category) noexcept
+	: recorder(trace_recorder::current()), name(name), category(category) {
+	if (recorder != nullptr)
+		start = trace_recorder::clock_type::now();
+}
+
+inline trace_span::~trace_span() {
+	if (recorder != nullptr)
+		recorder->record(name, category, start, trace_recorder::clock_type::now());
+}
+
+#endif
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_TRACED_FUNCTION_H
+#define GENETIC_ALGORITHM_LIBRARY_TRACED_FUNCTION_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <gsl/gsl_assert>
+#include "trace_recorder.h"
+
+/// Function object recording every \a period-th call of \a function as a span of the current \c trace_recorder
+/**
+Wrap an operator plugged into the context, such as the breeder or the
+evaluator, to see how long single calls take and how they spread over
+the threads. Every wrapped function counts its own calls with an atomic
+counter, so a wrapped evaluator may still be called concurrently, and
+the calls made on all threads together are sampled once in \a period;
+the other calls only cost an increment and a comparison.
+*/
+template<class Function>
+class traced_function {
+public:
+	traced_function(const char* name, const Function& function, std::size_t period = 1);
+	traced_function(const traced_function& other);
+	template<class... Args>
+	decltype(auto) operator()(Args&&... args);
+private:
+	const char* name;
+	Function function;
+	std::size_t period;
+	std::atomic<std::size_t> calls {0};
+};
+
+template<class Function>
+inline traced_function<Function>::traced_function(const char* name, const Function& function, std::size_t period)
+	: name(name), function(function), period(period) {
+	Expects(period > 0);
+}
+
+template<class Function>
+inline traced_function<Function>::traced_function(const traced_function& other)
+	: name(other.name), function(other.function), period(other.period), calls(other.calls.load(std::memory_order_relaxed)) {}
+
+template<class Function>
+template<class... Args>
+inline decltype(auto) traced_function<Function>::operator()(Args&&... args) {
+	if (calls.fetch_add(1, std::memory_order_relaxed) % period != period - 1)
+		return function(std::forward<Args>(args)...);
+	trace_span span(name, "operator");
+	return function(std::forward<Args>(args)...);
+}
+
+#endif
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef GENETIC_ALGORITHM_LIBRARY_XOSHIRO256_STAR_STAR_H
+#define GENETIC_ALGORITHM_LIBRARY_XOSHIRO256_STAR_STAR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/// The xoshiro256** engine by David Blackman and Sebastiano Vigna
+/**
+Satisfies the requirements of UniformRandomBitGenerator. The state is
+initialized from a single 64-bit seed with splitmix64. jump() advances
+the engine by 2^128 steps and long_jump() by 2^192 steps, which splits
+the period into non-overlapping streams.
+*/
+class xoshiro256_star_star {
+public:
+	using result_type = std::uint64_t;
+	static constexpr result_type default_seed = 0;
+	explicit xoshiro256_star_star(result_type value = default_seed) noexcept;
+	void seed(result_type value = default_seed) noexcept;
+	static constexpr result_type min() noexcept;
+	static constexpr result_type max() noexcept;
+	result_type operator()() noexcept;
+	void discard(unsigned long long z) noexcept;
+	void jump() noexcept;
+	void long_jump() noexcept;
+	friend bool operator==(const xoshiro256_star_star& lhs, const xoshiro256_star_star& rhs) noexcept;
+	friend bool operator!=(const xoshiro256_star_star& lhs, const xoshiro256_star_star& rhs) noexcept;
+private:
+	using state_type = std::array<result_type, 4>;
+	static constexpr result_type rotl(result_type x, int k) noexcept;
+	void jump(const state_type& polynomial) noexcept;
+	state_type state;
+};
+
+inline xoshiro256_star_star::xoshiro256_star_star(result_type value) noexcept {
+	seed(value);
+}
+
+inline void xoshiro256_star_star::seed(result_type value) noexcept {
+	for (auto&& word : state) {
+		result_type z = (value += 0x9E3779B97F4A7C15u);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+		word = z ^ (z >> 31);
+	}
+}
+
+constexpr auto xoshiro256_star_star::min() noexcept -> result_type {
+	return std::numeric_limits<result_type>::min();
+}
+
+constexpr auto xoshiro256_star_star::max() noexcept -> result_type {
+	return std::numeric_limits<result_type>::max();
+}
+
+inline auto xoshiro256_star_star::operator()() noexcept -> result_type {
+	const result_type result = rotl(state[1] * 5, 7) * 9;
+	const result_type t = state[1] << 17;
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= t;
+	state[3] = rotl(state[3], 45);
+	return result;
+}
+
+inline void xoshiro256_star_star::discard(unsigned long long z) noexcept {
+	while (z--) {
+		(*this)();
+	}
+}
+
+inline void xoshiro256_star_star::jump() noexcept {
+	jump({0x180EC6D33CFD0ABAu, 0xD5A61266F0C9392Cu, 0xA9582618E03FC9AAu, 0x39ABDC4529B1661Cu});
+}
+
+inline void xoshiro256_star_star::long_jump() noexcept {
+	jump({0x76E15D3EFEFDCBBFu, 0xC5004E441C522FB3u, 0x77710069854EE241u, 0x39109BB02ACBE635u});
+}
+
+inline bool operator==(const xoshiro256_star_star& lhs, const xoshiro256_star_star& rhs) noexcept {
+	return lhs.state == rhs.state;
+}
+
+inline bool operator!=(const xoshiro256_star_star& lhs, const xoshiro256_star_star& rhs) noexcept {
+	return !(lhs == rhs);
+}
+
+constexpr auto xoshiro256_star_star::rotl(result_type x, int k) noexcept -> result_type {
+	return (x << k) | (x >> (64 - k));
+}
+
+inline void xoshiro256_star_star::jump(const state_type& polynomial) noexcept {
+	state_type result {};
+	for (result_type word : polynomial) {
+		for (int bit = 0; bit < 64; bit++) {
+			if (word & (result_type(1) << bit)) {
+				for (std::size_t i = 0; i < result.size(); i++) {
+					result[i] ^= state[i];
+				}
+			}
+			(*this)();
+		}
+	}
+	state = result;
+}
+
+#endif
@@ -22,13 +22,14 @@
 //
 ////////////////////////////////////////////////////////////
 
-#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <limits>
 #include <random>
+#include <string>
 #include <genetics.h>
 #include "point.h"
 #include "point_breeder.h"
@@ -43,8 +44,11 @@ double f(const point& p) noexcept {
 	return a * a * 100.0 + b * b + 10.0;
 }
 
-int main() {
-	thread_safe_random_bit_generator<std::mt19937_64> rand;
+int main(int argc, char* argv[]) {
+	const std::uint64_t seed = argc > 1 ? std::stoull(argv[1]) : std::random_device()();
+	std::cout << "Seed: " << seed << std::endl;
+	const random_stream_family streams(seed);
+	xoshiro256_star_star rand = streams(0);
 	using algorithm_type = genetic_algorithm<point, double>;
 	algorithm_type::context_type context;
 	context.initial_population_size = 100;
@@ -57,6 +61,8 @@ int main() {
 	// context.selector = elitist_selection<std::greater<>>();
 	context.breeder = mutating_breeder(point_merge_coordinates(rand), point_mutator(0.1, rand));
 	context.comparator = std::greater<>();
+	// When evaluations are expensive, also try rating only the most promising half of the offspring exactly:
+	// context.screener = surrogate_screening(nearest_neighbor_surrogate<2>(), [](const point& p) { return std::array {p.x, p.y}; }, 0.5, std::greater<>());
 	algorithm_type algorithm(context);
 #ifdef LOGGING
 	std::ofstream out_log("point.log");
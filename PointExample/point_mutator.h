@@ -25,7 +25,7 @@
 #ifndef POINT_EXAMPLE_POINT_MUTATOR_H
 #define POINT_EXAMPLE_POINT_MUTATOR_H
 
-#include <random>
+#include <bulk_distribution.h>
 #include "point.h"
 
 template<class UniformRandomBitGenerator>
@@ -34,7 +34,7 @@ public:
 	point_mutator(double sigma, UniformRandomBitGenerator& g);
 	void operator()(point& p);
 private:
-	std::normal_distribution<> distribution;
+	bulk_normal_distribution distribution;
 	UniformRandomBitGenerator& rand;
 };
 
@@ -0,0 +1,43 @@
+#!/bin/sh
+#
+# Downloads the TSPLIB instances listed in instances.txt.
+#
+# Usage: fetch_instances.sh [directory] [name...]
+#
+# The instances are stored as <name>.tsp in the directory, by default the
+# one holding this script, together with a copy of instances.txt, so the
+# directory can be passed to SalesmanBenchmark as is. Given names, only
+# those instances are downloaded, for example the small ones:
+#
+#     fetch_instances.sh . a280 lin318 pcb442 att532 si535 gr666 rat783 pr1002
+#
+# Instances already present are skipped.
+
+set -e
+
+base=${TSPLIB_URL:-http://comopt.ifi.uni-heidelberg.de/software/TSPLIB95/tsp}
+here=$(cd "$(dirname "$0")" && pwd)
+directory=${1:-$here}
+[ $# -gt 0 ] && shift
+
+mkdir -p "$directory"
+if [ ! "$directory/instances.txt" -ef "$here/instances.txt" ]; then
+	cp "$here/instances.txt" "$directory/instances.txt"
+fi
+
+if [ $# -eq 0 ]; then
+	set -- $(cut -d ' ' -f 1 "$here/instances.txt")
+fi
+
+for name in "$@"; do
+	if [ -f "$directory/$name.tsp" ]; then
+		continue
+	fi
+	echo "Fetching $name"
+	if command -v curl > /dev/null; then
+		curl -fsSL "$base/$name.tsp.gz" -o "$directory/$name.tsp.gz"
+	else
+		wget -q "$base/$name.tsp.gz" -O "$directory/$name.tsp.gz"
+	fi
+	gunzip -f "$directory/$name.tsp.gz"
+done
@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <genetics.h>
+#include "candidate_list.h"
+#include "path_evaluator.h"
+#include "path_merger.h"
+#include "path_mutator.h"
+#include "permutation.h"
+#include "permutation_generator.h"
+#include "tour_construction.h"
+#include "tour_hash.h"
+#include "tsplib.h"
+
+using path_type = basic_permutation<std::uint32_t>;
+using algorithm_type = genetic_algorithm<path_type, long long>;
+
+struct solver_setup {
+	std::string name;
+	std::function<void(algorithm_type::context_type&, const tsplib_instance&, const candidate_list&, const random_stream_family<>&, xoshiro256_star_star&)> configure;
+};
+
+struct sample {
+	double seconds;
+	std::uint64_t evaluations;
+	long long length;
+};
+
+void configure_common(algorithm_type::context_type& context, const tsplib_instance& instance, const candidate_list& candidates, xoshiro256_star_star& rand) {
+	const bool large = instance.size() > 10000;
+	context.initial_population_size = large ? 100 : 1000;
+	context.breeding_population_size = large ? 30 : 100;
+	context.evaluator = path_evaluator(instance);
+	context.bounded_evaluator = path_evaluator(instance);
+	context.selector = elitist_selection<std::greater<>>();
+	context.streaming_selector = elitist_selection<std::greater<>>();
+	context.threshold_streaming = true;
+	context.breeder = path_merger(rand);
+	context.mutator = chain_mutation {
+		batch_mutation(rand, 0.2, path_node_swapper(rand)),
+		batch_mutation(rand, 0.1, path_node_relocator(rand)),
+		batch_mutation(rand, 0.1, path_neighbor_inverter(rand, candidates)),
+	};
+	context.comparator = std::greater<>();
+	context.fingerprint = canonical_tour_hash();
+}
+
+/// The configurations compared by the benchmark; add an entry to measure an engine change
+const std::vector<solver_setup> setups {
+	{"random", [](algorithm_type::context_type& context, const tsplib_instance& instance, const candidate_list& candidates, const random_stream_family<>&, xoshiro256_star_star& rand) {
+		configure_common(context, instance, candidates, rand);
+		context.generator = permutation_generator<xoshiro256_star_star, path_type>(instance.size(), rand);
+	}},
+	{"seeded", [](algorithm_type::context_type& context, const tsplib_instance& instance, const candidate_list& candidates, const random_stream_family<>& streams, xoshiro256_star_star& rand) {
+		configure_common(context, instance, candidates, rand);
+		const auto& positions = instance.positions();
+		if (instance.size() <= 2000 || positions.empty()) {
+			context.generator = parallel_generator(streams(1), context.initial_population_size, tour_seeder<path_type, tsplib_instance>(instance, candidates, positions));
+		} else {
+			context.generator = parallel_generator(streams(1), context.initial_population_size, [positions](xoshiro256_star_star& g) {
+				return space_filling_curve_tour<path_type>(positions, g);
+			});
+		}
+	}},
+};
+
+const std::vector<double> target_gaps {0.1, 0.05, 0.02, 0.01};
+const std::vector<double> profile_ratios {1.0, 1.25, 1.5, 2.0, 3.0, 5.0, 10.0};
+
+/// Runs one setup once, recording every improvement of the best exactly rated tour seen by the observer
+std::vector<sample> solve(const solver_setup& setup, const tsplib_instance& instance, const candidate_list& candidates, std::size_t iterations, std::uint64_t seed) {
+	const random_stream_family streams(seed);
+	xoshiro256_star_star rand = streams(0);
+	algorithm_type::context_type context;
+	context.max_iterations = iterations;
+	setup.configure(context, instance, candidates, streams, rand);
+	std::atomic<std::uint64_t> evaluations(0);
+	context.evaluator = [&evaluations, evaluator = context.evaluator](const path_type& path) {
+		evaluations++;
+		return evaluator(path);
+	};
+	if (context.bounded_evaluator != nullptr) {
+		context.bounded_evaluator = [&evaluations, evaluator = context.bounded_evaluator](const path_type& path, long long cutoff) {
+			evaluations++;
+			return evaluator(path, cutoff);
+		};
+	}
+	std::vector<sample> trace;
+	const auto start = std::chrono::steady_clock::now();
+	const auto record = [&](long long length) {
+		if (trace.empty() || length < trace.back().length)
+			trace.push_back({std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), evaluations.load(), length});
+	};
+	const auto result = algorithm_type(context)([&](const algorithm_type&, algorithm_type::stage_type, const algorithm_type::population_type& specimens) {
+		long long best = std::numeric_limits<long long>::max();
+		for (const auto& specimen : specimens) {
+			if (specimen.has_rating() && !specimen.is_approximate() && !specimen.is_bound())
+				best = std::min(best, specimen.rating());
+		}
+		record(best);
+	});
+	record(result.rating());
+	return trace;
+}
+
+/// Usage: SalesmanBenchmark [directory] [runs] [iterations] [seed]
+/**
+Solves every instance listed in \c instances.txt in \a directory with
+every setup, reading the instances from the TSPLIB files next to it.
+fetch_instances.sh downloads them from the TSPLIB site.
+*/
+int main(int argc, char* argv[]) {
+	std::ios::sync_with_stdio(false);
+	const std::string directory = argc > 1 ? argv[1] : ".";
+	const std::size_t runs = argc > 2 ? std::stoull(argv[2]) : 5;
+	const std::size_t iterations = argc > 3 ? std::stoull(argv[3]) : 100;
+	const std::uint64_t seed = argc > 4 ? std::stoull(argv[4]) : std::random_device()();
+	std::cout << "Seed: " << seed << std::endl;
+	std::ifstream manifest(directory + "/instances.txt");
+	if (!manifest) {
+		std::cerr << directory << "/instances.txt not found" << std::endl;
+		return 1;
+	}
+	std::ofstream out_trace("benchmark_trace.csv");
+	out_trace << "setup,instance,run,seconds,evaluations,length,gap\n";
+	std::map<std::tuple<std::string, std::string, double>, std::tuple<std::size_t, double, double>> reached;
+	std::vector<std::string> instances;
+	std::string name;
+	long long optimum;
+	while (manifest >> name >> optimum) {
+		std::ifstream in(directory + '/' + name + ".tsp");
+		if (!in) {
+			std::cerr << "Skipping " << name << ": " << directory << '/' << name << ".tsp not found" << std::endl;
+			continue;
+		}
+		const tsplib_instance instance = read_tsplib(in);
+		const auto& positions = instance.positions();
+		const candidate_list candidates = positions.empty() ? nearest_neighbors_by_distance(instance, 8) : nearest_neighbors(positions, 8);
+		instances.push_back(name);
+		for (const auto& setup : setups) {
+			for (std::size_t run = 0; run < runs; run++) {
+				const auto trace = solve(setup, instance, candidates, iterations, seed + run);
+				for (const auto& [seconds, evaluations, length] : trace) {
+					out_trace << setup.name << ',' << name << ',' << run << ',' << seconds << ',' << evaluations << ',' << length << ',' << double(length - optimum) / optimum << '\n';
+				}
+				for (const double target : target_gaps) {
+					const auto hit = std::find_if(trace.begin(), trace.end(), [&](const sample& s) {
+						return s.length <= optimum * (1.0 + target);
+					});
+					if (hit == trace.end())
+						continue;
+					auto& [count, seconds, evaluations] = reached[{setup.name, name, target}];
+					count++;
+					seconds += hit->seconds;
+					evaluations += double(hit->evaluations);
+				}
+				std::cout << setup.name << " on " << name << ", run " << run << ": " << trace.back().length << " (optimum " << optimum << ")" << std::endl;
+			}
+		}
+	}
+	std::ofstream out_summary("benchmark_summary.csv");
+	out_summary << "setup,instance,target,reached,runs,mean_seconds,mean_evaluations\n";
+	std::map<std::tuple<std::string, double>, std::map<std::string, double>> costs;
+	for (const auto& setup : setups) {
+		for (const auto& instance : instances) {
+			for (const double target : target_gaps) {
+				const auto it = reached.find({setup.name, instance, target});
+				out_summary << setup.name << ',' << instance << ',' << target << ',';
+				if (it == reached.end()) {
+					out_summary << 0 << ',' << runs << ",,\n";
+					continue;
+				}
+				const auto& [count, seconds, evaluations] = it->second;
+				out_summary << count << ',' << runs << ',' << seconds / count << ',' << evaluations / count << '\n';
+				if (count == runs)
+					costs[{instance, target}][setup.name] = seconds / count;
+			}
+		}
+	}
+	// Performance profile over the (instance, target) pairs that some setup reached in every run:
+	// the fraction of them each setup reached within a given ratio of the fastest mean time.
+	std::ofstream out_profile("benchmark_profile.csv");
+	out_profile << "setup,ratio,fraction\n";
+	for (const auto& setup : setups) {
+		for (const double ratio : profile_ratios) {
+			std::size_t solved = 0;
+			for (const auto& [problem, times] : costs) {
+				const auto fastest = std::min_element(times.begin(), times.end(), [](const auto& lhs, const auto& rhs) {
+					return lhs.second < rhs.second;
+				});
+				const auto own = times.find(setup.name);
+				if (own != times.end() && own->second <= ratio * fastest->second)
+					solved++;
+			}
+			out_profile << setup.name << ',' << ratio << ',' << (costs.empty() ? 0.0 : double(solved) / costs.size()) << '\n';
+		}
+	}
+	return 0;
+}
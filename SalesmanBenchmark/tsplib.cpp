@@ -0,0 +1,191 @@
+#include "tsplib.h"
+#include <cmath>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include <gsl/gsl_util>
+
+struct tsplib_instance::data_type {
+	std::string name;
+	edge_weight_type type = edge_weight_type::euclidean;
+	std::size_t size = 0;
+	std::vector<std::pair<double, double>> positions;
+	std::vector<std::pair<double, double>> coordinates;
+	std::vector<distance_type> weights;
+	std::vector<row_type> rows;
+	distance_type distance(std::size_t from, std::size_t to) const;
+};
+
+auto tsplib_instance::data_type::distance(std::size_t from, std::size_t to) const -> distance_type {
+	if (type == edge_weight_type::explicit_weights)
+		return weights[from * size + to];
+	const auto& [x1, y1] = coordinates[from];
+	const auto& [x2, y2] = coordinates[to];
+	switch (type) {
+		case edge_weight_type::ceiling:
+			return static_cast<distance_type>(std::ceil(std::hypot(x1 - x2, y1 - y2)));
+		case edge_weight_type::pseudo_euclidean: {
+			const double exact = std::sqrt(((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2)) / 10.0);
+			const auto rounded = static_cast<distance_type>(exact + 0.5);
+			return rounded < exact ? rounded + 1 : rounded;
+		}
+		case edge_weight_type::geographical: {
+			constexpr double radius = 6378.388;
+			const double q1 = std::cos(y1 - y2);
+			const double q2 = std::cos(x1 - x2);
+			const double q3 = std::cos(x1 + x2);
+			return static_cast<distance_type>(radius * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+		}
+		default:
+			return static_cast<distance_type>(std::hypot(x1 - x2, y1 - y2) + 0.5);
+	}
+}
+
+tsplib_instance::row_type::row_type(const tsplib_instance::data_type& data, std::size_t from) noexcept
+	: data(&data), from(from) {}
+
+std::size_t tsplib_instance::row_type::size() const noexcept {
+	return data->size;
+}
+
+auto tsplib_instance::row_type::operator[](std::size_t to) const -> value_type {
+	return data->distance(from, to);
+}
+
+const std::string& tsplib_instance::name() const noexcept {
+	return data->name;
+}
+
+auto tsplib_instance::weight_type() const noexcept -> edge_weight_type {
+	return data->type;
+}
+
+std::size_t tsplib_instance::size() const noexcept {
+	return data->size;
+}
+
+auto tsplib_instance::operator[](std::size_t city) const -> const row_type& {
+	return data->rows[city];
+}
+
+auto tsplib_instance::distance(std::size_t from, std::size_t to) const -> distance_type {
+	Expects(from < size());
+	Expects(to < size());
+	return data->distance(from, to);
+}
+
+const std::vector<std::pair<double, double>>& tsplib_instance::positions() const noexcept {
+	return data->positions;
+}
+
+namespace {
+	std::string trim(const std::string& text) {
+		const auto first = text.find_first_not_of(" \t\r");
+		if (first == std::string::npos)
+			return std::string();
+		return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+	}
+
+	void read_positions(std::istream& in, std::vector<std::pair<double, double>>& positions) {
+		for (std::size_t i = 0; i < positions.size(); i++) {
+			std::size_t city;
+			double x, y;
+			if (!(in >> city >> x >> y) || city < 1 || city > positions.size())
+				throw std::runtime_error("malformed coordinate section");
+			positions[city - 1] = {x, y};
+		}
+	}
+
+	void read_weights(std::istream& in, std::size_t size, const std::string& format, std::vector<long long>& weights) {
+		weights.assign(size * size, 0);
+		const bool upper = format == "UPPER_ROW" || format == "UPPER_DIAG_ROW";
+		const bool diagonal = format == "FULL_MATRIX" || format == "UPPER_DIAG_ROW" || format == "LOWER_DIAG_ROW";
+		if (!upper && !diagonal && format != "LOWER_ROW")
+			throw std::runtime_error("unsupported edge weight format " + format);
+		for (std::size_t from = 0; from < size; from++) {
+			const std::size_t first = format == "FULL_MATRIX" ? 0 : upper ? from + !diagonal : 0;
+			const std::size_t last = format == "FULL_MATRIX" ? size : upper ? size : from + diagonal;
+			for (std::size_t to = first; to < last; to++) {
+				long long weight;
+				if (!(in >> weight))
+					throw std::runtime_error("malformed edge weight section");
+				weights[from * size + to] = weight;
+				weights[to * size + from] = weight;
+			}
+		}
+	}
+
+	double to_radians(double degrees_minutes) noexcept {
+		constexpr double pi = 3.141592;
+		const double degrees = std::trunc(degrees_minutes);
+		return pi * (degrees + 5.0 * (degrees_minutes - degrees) / 3.0) / 180.0;
+	}
+}
+
+tsplib_instance read_tsplib(std::istream& in) {
+	using edge_weight_type = tsplib_instance::edge_weight_type;
+	auto data = std::make_shared<tsplib_instance::data_type>();
+	std::string format = "FULL_MATRIX";
+	std::vector<std::pair<double, double>> coordinates;
+	std::string line;
+	while (std::getline(in, line)) {
+		const auto colon = line.find(':');
+		const std::string keyword = trim(line.substr(0, colon));
+		const std::string value = colon == std::string::npos ? std::string() : trim(line.substr(colon + 1));
+		if (keyword == "NAME") {
+			data->name = value;
+		} else if (keyword == "TYPE") {
+			if (value != "TSP")
+				throw std::runtime_error("unsupported problem type " + value);
+		} else if (keyword == "DIMENSION") {
+			data->size = std::stoull(value);
+		} else if (keyword == "EDGE_WEIGHT_TYPE") {
+			if (value == "EUC_2D")
+				data->type = edge_weight_type::euclidean;
+			else if (value == "CEIL_2D")
+				data->type = edge_weight_type::ceiling;
+			else if (value == "ATT")
+				data->type = edge_weight_type::pseudo_euclidean;
+			else if (value == "GEO")
+				data->type = edge_weight_type::geographical;
+			else if (value == "EXPLICIT")
+				data->type = edge_weight_type::explicit_weights;
+			else
+				throw std::runtime_error("unsupported edge weight type " + value);
+		} else if (keyword == "EDGE_WEIGHT_FORMAT") {
+			format = value;
+		} else if (keyword == "NODE_COORD_SECTION" || keyword == "DISPLAY_DATA_SECTION") {
+			coordinates.resize(data->size);
+			read_positions(in, coordinates);
+		} else if (keyword == "EDGE_WEIGHT_SECTION") {
+			read_weights(in, data->size, format, data->weights);
+		} else if (keyword == "EOF") {
+			break;
+		}
+	}
+	if (data->size == 0)
+		throw std::runtime_error("missing dimension");
+	if (data->type == edge_weight_type::explicit_weights ? data->weights.empty() : coordinates.empty())
+		throw std::runtime_error("missing " + std::string(data->type == edge_weight_type::explicit_weights ? "edge weight" : "coordinate") + " section");
+	data->positions = coordinates;
+	if (data->type == edge_weight_type::geographical) {
+		for (auto&& [latitude, longitude] : coordinates) {
+			latitude = to_radians(latitude);
+			longitude = to_radians(longitude);
+		}
+	}
+	if (data->type != edge_weight_type::explicit_weights)
+		data->coordinates = std::move(coordinates);
+	data->rows.reserve(data->size);
+	for (std::size_t city = 0; city < data->size; city++) {
+		data->rows.emplace_back(*data, city);
+	}
+	tsplib_instance result;
+	result.data = std::move(data);
+	return result;
+}
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SALESMAN_BENCHMARK_TSPLIB_H
+#define SALESMAN_BENCHMARK_TSPLIB_H
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// A symmetric TSPLIB instance, usable as a distance matrix
+/**
+Indexing gives a row whose elements are the distances from one city, as
+with a \c std::vector of rows, but for instances given by coordinates
+the distances are computed on access, so instances with 100,000 cities
+fit in memory. Copies share the instance data.
+*/
+class tsplib_instance {
+public:
+	enum struct edge_weight_type { euclidean, ceiling, pseudo_euclidean, geographical, explicit_weights };
+	class row_type;
+	using value_type = row_type;
+	using distance_type = long long;
+	const std::string& name() const noexcept;
+	edge_weight_type weight_type() const noexcept;
+	std::size_t size() const noexcept;
+	const row_type& operator[](std::size_t city) const;
+	distance_type distance(std::size_t from, std::size_t to) const;
+	const std::vector<std::pair<double, double>>& positions() const noexcept;
+	friend tsplib_instance read_tsplib(std::istream& in);
+private:
+	struct data_type;
+	std::shared_ptr<const data_type> data;
+};
+
+class tsplib_instance::row_type {
+public:
+	using value_type = distance_type;
+	row_type(const tsplib_instance::data_type& data, std::size_t from) noexcept;
+	std::size_t size() const noexcept;
+	value_type operator[](std::size_t to) const;
+private:
+	const tsplib_instance::data_type* data;
+	std::size_t from;
+};
+
+/// Reads an instance in the TSPLIB format
+/**
+Supports what the symmetric TSP instances of the library use: EUC_2D,
+CEIL_2D, ATT and GEO coordinates, and EXPLICIT weights in the FULL_MATRIX,
+UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW and LOWER_DIAG_ROW formats, with
+optional display coordinates. Throws \c std::runtime_error on anything
+else.
+*/
+tsplib_instance read_tsplib(std::istream& in);
+
+#endif
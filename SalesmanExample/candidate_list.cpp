@@ -0,0 +1,40 @@
+#include "candidate_list.h"
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include <gsl/gsl_util>
+#include <gsl/span>
+#include "kd_tree.h"
+
+candidate_list::candidate_list(std::size_t size, std::size_t width, std::vector<unsigned>&& neighbors)
+	: city_count(size), neighbor_count(width), neighbors(std::move(neighbors)) {
+	Expects(this->neighbors.size() == size * width);
+}
+
+std::size_t candidate_list::size() const noexcept {
+	return city_count;
+}
+
+std::size_t candidate_list::width() const noexcept {
+	return neighbor_count;
+}
+
+gsl::span<const unsigned> candidate_list::operator[](std::size_t city) const {
+	Expects(city < size());
+	return {neighbors.data() + city * neighbor_count, gsl::narrow_cast<std::ptrdiff_t>(neighbor_count)};
+}
+
+candidate_list nearest_neighbors(const std::vector<std::pair<double, double>>& positions, std::size_t k) {
+	const std::size_t size = positions.size();
+	Expects(size > 0);
+	const std::size_t width = std::min(k, size - 1);
+	const kd_tree tree(positions);
+	std::vector<unsigned> neighbors;
+	neighbors.reserve(size * width);
+	for (std::size_t city = 0; city < size; city++) {
+		tree.nearest(city, width, neighbors);
+	}
+	return candidate_list(size, width, std::move(neighbors));
+}
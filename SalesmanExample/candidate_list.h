@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SALESMAN_EXAMPLE_CANDIDATE_LIST_H
+#define SALESMAN_EXAMPLE_CANDIDATE_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include <gsl/gsl_util>
+#include <gsl/span>
+
+/// Nearest neighbor candidates of every city, stored row by row in one flat array
+class candidate_list {
+public:
+	candidate_list(std::size_t size, std::size_t width, std::vector<unsigned>&& neighbors);
+	std::size_t size() const noexcept;
+	std::size_t width() const noexcept;
+	gsl::span<const unsigned> operator[](std::size_t city) const;
+private:
+	std::size_t city_count;
+	std::size_t neighbor_count;
+	std::vector<unsigned> neighbors;
+};
+
+candidate_list nearest_neighbors(const std::vector<std::pair<double, double>>& positions, std::size_t k);
+
+template<class Matrix>
+candidate_list nearest_neighbors_by_distance(const Matrix& matrix, std::size_t k) {
+	const std::size_t size = matrix.size();
+	Expects(size > 0);
+	const std::size_t width = std::min(k, size - 1);
+	std::vector<unsigned> neighbors;
+	neighbors.reserve(size * width);
+	std::vector<unsigned> others(size - 1);
+	for (unsigned city = 0; city < size; city++) {
+		const auto& row = gsl::at(matrix, city);
+		std::iota(others.begin(), others.begin() + city, 0u);
+		std::iota(others.begin() + city, others.end(), city + 1);
+		const auto closer = [&](unsigned lhs, unsigned rhs) {
+			return std::make_pair(gsl::at(row, lhs), lhs) < std::make_pair(gsl::at(row, rhs), rhs);
+		};
+		std::partial_sort(others.begin(), others.begin() + width, others.end(), closer);
+		neighbors.insert(neighbors.end(), others.begin(), others.begin() + width);
+	}
+	return candidate_list(size, width, std::move(neighbors));
+}
+
+#endif
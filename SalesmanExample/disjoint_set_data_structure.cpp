@@ -1,11 +1,12 @@
 #include "disjoint_set_data_structure.h"
 #include <cstddef>
+#include <memory_resource>
 #include <numeric>
 #include <gsl/gsl_assert>
 #include <gsl/gsl_util>
 
-disjoint_set_data_structure::disjoint_set_data_structure(std::size_t n)
-	: parents(n), ranks(n) {
+disjoint_set_data_structure::disjoint_set_data_structure(std::size_t n, std::pmr::memory_resource* resource)
+	: parents(n, resource), ranks(n, resource) {
 	std::iota(parents.begin(), parents.end(), std::size_t());
 }
 
@@ -26,16 +26,17 @@
 #define SALESMAN_EXAMPLE_DISJOINT_SET_DATA_STRUCTURE_H
 
 #include <cstddef>
+#include <memory_resource>
 #include <vector>
 
 class disjoint_set_data_structure {
 public:
-	explicit disjoint_set_data_structure(std::size_t n);
+	explicit disjoint_set_data_structure(std::size_t n, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 	std::size_t find(std::size_t index) const;
 	bool merge(std::size_t lhs, std::size_t rhs);
 private:
-	mutable std::vector<std::size_t> parents;
-	std::vector<std::size_t> ranks;
+	mutable std::pmr::vector<std::size_t> parents;
+	std::pmr::vector<std::size_t> ranks;
 };
 
 #endif
@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SALESMAN_EXAMPLE_FIXED_CAPACITY_VECTOR_H
+#define SALESMAN_EXAMPLE_FIXED_CAPACITY_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <gsl/gsl_assert>
+
+/// A sequence container with inline storage for at most \a Capacity trivial elements
+template<class T, std::size_t Capacity>
+class fixed_capacity_vector {
+	static_assert(std::is_trivial_v<T>, "fixed_capacity_vector only holds trivial types");
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+	using iterator = pointer;
+	using const_iterator = const_pointer;
+	constexpr fixed_capacity_vector() noexcept = default;
+	explicit fixed_capacity_vector(size_type n);
+	fixed_capacity_vector(size_type n, const value_type& value);
+	constexpr iterator begin() noexcept;
+	constexpr const_iterator begin() const noexcept;
+	constexpr iterator end() noexcept;
+	constexpr const_iterator end() const noexcept;
+	constexpr bool empty() const noexcept;
+	constexpr size_type size() const noexcept;
+	static constexpr size_type capacity() noexcept;
+	static constexpr size_type max_size() noexcept;
+	void reserve(size_type n) const;
+	constexpr pointer data() noexcept;
+	constexpr const_pointer data() const noexcept;
+	constexpr reference operator[](size_type n);
+	constexpr const_reference operator[](size_type n) const;
+	constexpr reference front();
+	constexpr const_reference front() const;
+	constexpr reference back();
+	constexpr const_reference back() const;
+	void push_back(const value_type& value);
+	void pop_back();
+	void resize(size_type n, const value_type& value = value_type());
+	void clear() noexcept;
+private:
+	size_type count = 0;
+	std::array<value_type, Capacity> elements {};
+};
+
+template<class T, std::size_t Capacity>
+inline fixed_capacity_vector<T, Capacity>::fixed_capacity_vector(size_type n) {
+	resize(n);
+}
+
+template<class T, std::size_t Capacity>
+inline fixed_capacity_vector<T, Capacity>::fixed_capacity_vector(size_type n, const value_type& value) {
+	resize(n, value);
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::begin() noexcept -> iterator {
+	return elements.data();
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::begin() const noexcept -> const_iterator {
+	return elements.data();
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::end() noexcept -> iterator {
+	return elements.data() + count;
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::end() const noexcept -> const_iterator {
+	return elements.data() + count;
+}
+
+template<class T, std::size_t Capacity>
+constexpr bool fixed_capacity_vector<T, Capacity>::empty() const noexcept {
+	return count == 0;
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::size() const noexcept -> size_type {
+	return count;
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::capacity() noexcept -> size_type {
+	return Capacity;
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::max_size() noexcept -> size_type {
+	return Capacity;
+}
+
+template<class T, std::size_t Capacity>
+inline void fixed_capacity_vector<T, Capacity>::reserve(size_type n) const {
+	Expects(n <= Capacity);
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::data() noexcept -> pointer {
+	return elements.data();
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::data() const noexcept -> const_pointer {
+	return elements.data();
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::operator[](size_type n) -> reference {
+	return elements[n];
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::operator[](size_type n) const -> const_reference {
+	return elements[n];
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::front() -> reference {
+	return elements[0];
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::front() const -> const_reference {
+	return elements[0];
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::back() -> reference {
+	return elements[count - 1];
+}
+
+template<class T, std::size_t Capacity>
+constexpr auto fixed_capacity_vector<T, Capacity>::back() const -> const_reference {
+	return elements[count - 1];
+}
+
+template<class T, std::size_t Capacity>
+inline void fixed_capacity_vector<T, Capacity>::push_back(const value_type& value) {
+	Expects(count < Capacity);
+	elements[count++] = value;
+}
+
+template<class T, std::size_t Capacity>
+inline void fixed_capacity_vector<T, Capacity>::pop_back() {
+	Expects(count > 0);
+	count--;
+}
+
+template<class T, std::size_t Capacity>
+inline void fixed_capacity_vector<T, Capacity>::resize(size_type n, const value_type& value) {
+	Expects(n <= Capacity);
+	if (n > count)
+		std::fill(elements.begin() + count, elements.begin() + n, value);
+	count = n;
+}
+
+template<class T, std::size_t Capacity>
+inline void fixed_capacity_vector<T, Capacity>::clear() noexcept {
+	count = 0;
+}
+
+template<class T, std::size_t Capacity>
+inline bool operator==(const fixed_capacity_vector<T, Capacity>& lhs, const fixed_capacity_vector<T, Capacity>& rhs) {
+	return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template<class T, std::size_t Capacity>
+inline bool operator!=(const fixed_capacity_vector<T, Capacity>& lhs, const fixed_capacity_vector<T, Capacity>& rhs) {
+	return !(lhs == rhs);
+}
+
+#endif
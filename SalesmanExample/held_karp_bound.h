@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SALESMAN_EXAMPLE_HELD_KARP_BOUND_H
+#define SALESMAN_EXAMPLE_HELD_KARP_BOUND_H
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <gsl/gsl_assert>
+
+/// Held-Karp lower bound on the length of the shortest tour, improved on a thread of its own
+/**
+The bound is the weight of a minimum 1-tree under node penalties found
+by subgradient ascent: a minimum spanning tree of all cities but the
+first, joined to the first city by its two shortest edges, with every
+distance increased by the penalties of both its ends, less twice the sum
+of the penalties. Every tour is a 1-tree, so the bound never exceeds the
+length of the shortest tour, and it usually comes within a percent or
+two of it. The distances have to be symmetric. Each step takes time
+quadratic in the number of cities.
+
+Steps follow Polyak's rule towards the shortest tour known, at first a
+nearest neighbor tour, and the step factor is halved whenever the bound
+stops improving. The ascent ends when the 1-tree is a tour, which is
+then optimal, when the step factor becomes negligible, or when the
+object is destroyed.
+*/
+template<class Matrix>
+class held_karp_bound {
+public:
+	using matrix_type = Matrix;
+	using row_type = typename matrix_type::value_type;
+	using value_type = typename row_type::value_type;
+	explicit held_karp_bound(const matrix_type& matrix);
+	held_karp_bound(const held_karp_bound&) = delete;
+	held_karp_bound& operator=(const held_karp_bound&) = delete;
+	~held_karp_bound();
+	double lower_bound() const noexcept;
+	bool converged() const noexcept;
+	void improve_upper_bound(value_type length) noexcept;
+	bool within(value_type length, double gap) noexcept;
+private:
+	static constexpr std::size_t patience = 30;
+	static constexpr double min_step_factor = 1e-4;
+	double nearest_neighbor_length() const;
+	double one_tree(const std::vector<double>& penalties, std::vector<int>& degrees) const;
+	void ascend();
+	matrix_type matrix;
+	std::atomic<double> bound {-std::numeric_limits<double>::infinity()};
+	std::atomic<double> upper_bound {std::numeric_limits<double>::infinity()};
+	std::atomic<bool> stopping {false};
+	std::atomic<bool> done {false};
+	std::thread worker;
+};
+
+template<class Matrix>
+inline held_karp_bound<Matrix>::held_karp_bound(const matrix_type& matrix)
+	: matrix(matrix) {
+	Expects(this->matrix.size() >= 3);
+	worker = std::thread(&held_karp_bound::ascend, this);
+}
+
+template<class Matrix>
+inline held_karp_bound<Matrix>::~held_karp_bound() {
+	stopping = true;
+	worker.join();
+}
+
+/// The best bound so far, rounded up for integral distances
+template<class Matrix>
+inline double held_karp_bound<Matrix>::lower_bound() const noexcept {
+	const double result = bound.load(std::memory_order_relaxed);
+	if constexpr (std::is_integral_v<value_type>)
+		return std::ceil(result - 1e-9 * std::abs(result));
+	else
+		return result;
+}
+
+/// Tells whether the ascent has ended, so the bound will not improve any more
+template<class Matrix>
+inline bool held_karp_bound<Matrix>::converged() const noexcept {
+	return done.load(std::memory_order_acquire);
+}
+
+/// Lets the ascent aim at the length of a shorter tour, such as the best one found so far
+template<class Matrix>
+inline void held_karp_bound<Matrix>::improve_upper_bound(value_type length) noexcept {
+	double current = upper_bound.load(std::memory_order_relaxed);
+	while (length < current && !upper_bound.compare_exchange_weak(current, static_cast<double>(length), std::memory_order_relaxed));
+}
+
+/// Tells whether a tour of \a length is known to be longer than the shortest one by at most the fraction \a gap
+/**
+The length is also taken as an upper bound, so this makes a terminator
+for the context of the algorithm stopping once the best tour is close
+enough to optimal.
+*/
+template<class Matrix>
+inline bool held_karp_bound<Matrix>::within(value_type length, double gap) noexcept {
+	improve_upper_bound(length);
+	const double lower = lower_bound();
+	return lower > 0 && length <= lower * (1 + gap);
+}
+
+template<class Matrix>
+inline double held_karp_bound<Matrix>::nearest_neighbor_length() const {
+	const std::size_t n = matrix.size();
+	std::vector<bool> visited(n, false);
+	std::size_t city = 0;
+	visited[city] = true;
+	double result = 0;
+	for (std::size_t i = 1; i < n; i++) {
+		const row_type& row = matrix[city];
+		std::size_t next = n;
+		for (std::size_t j = 0; j < n; j++) {
+			if (!visited[j] && (next == n || row[j] < row[next]))
+				next = j;
+		}
+		result += row[next];
+		visited[next] = true;
+		city = next;
+	}
+	return result + matrix[city][0];
+}
+
+/// Weight of a minimum 1-tree under \a penalties, with the degrees of its nodes stored in \a degrees
+template<class Matrix>
+inline double held_karp_bound<Matrix>::one_tree(const std::vector<double>& penalties, std::vector<int>& degrees) const {
+	const std::size_t n = matrix.size();
+	constexpr double infinity = std::numeric_limits<double>::infinity();
+	std::vector<double> key(n, infinity);
+	std::vector<std::size_t> parent(n, 0);
+	std::vector<bool> in_tree(n, false);
+	degrees.assign(n, 0);
+	double result = 0;
+	key[1] = 0;
+	for (std::size_t k = 1; k < n; k++) {
+		std::size_t city = 0;
+		for (std::size_t v = 1; v < n; v++) {
+			if (!in_tree[v] && (city == 0 || key[v] < key[city]))
+				city = v;
+		}
+		in_tree[city] = true;
+		result += key[city];
+		if (parent[city] != 0) {
+			degrees[city]++;
+			degrees[parent[city]]++;
+		}
+		const row_type& row = matrix[city];
+		for (std::size_t v = 1; v < n; v++) {
+			if (in_tree[v])
+				continue;
+			const double weight = row[v] + penalties[city] + penalties[v];
+			if (weight < key[v]) {
+				key[v] = weight;
+				parent[v] = city;
+			}
+		}
+	}
+	const row_type& row = matrix[0];
+	double first = infinity;
+	double second = infinity;
+	std::size_t first_city = 0;
+	std::size_t second_city = 0;
+	for (std::size_t v = 1; v < n; v++) {
+		const double weight = row[v] + penalties[0] + penalties[v];
+		if (weight < first) {
+			second = first;
+			second_city = first_city;
+			first = weight;
+			first_city = v;
+		} else if (weight < second) {
+			second = weight;
+			second_city = v;
+		}
+	}
+	degrees[0] = 2;
+	degrees[first_city]++;
+	degrees[second_city]++;
+	result += first + second;
+	for (const double penalty : penalties) {
+		result -= 2 * penalty;
+	}
+	return result;
+}
+
+template<class Matrix>
+inline void held_karp_bound<Matrix>::ascend() {
+	const std::size_t n = matrix.size();
+	improve_upper_bound(static_cast<value_type>(nearest_neighbor_length()));
+	std::vector<double> penalties(n, 0);
+	std::vector<int> degrees;
+	double best = -std::numeric_limits<double>::infinity();
+	double step_factor = 2;
+	std::size_t stale = 0;
+	while (!stopping.load(std::memory_order_relaxed)) {
+		const double weight = one_tree(penalties, degrees);
+		if (weight > best) {
+			best = weight;
+			bound.store(best, std::memory_order_relaxed);
+			stale = 0;
+		} else if (++stale == patience) {
+			step_factor /= 2;
+			stale = 0;
+			if (step_factor < min_step_factor)
+				break;
+		}
+		double norm = 0;
+		for (const int degree : degrees) {
+			norm += double(degree - 2) * (degree - 2);
+		}
+		const double target = upper_bound.load(std::memory_order_relaxed);
+		if (norm == 0 || weight >= target)
+			break;
+		const double step = step_factor * (target - weight) / norm;
+		for (std::size_t i = 0; i < n; i++) {
+			penalties[i] += step * (degrees[i] - 2);
+		}
+	}
+	done.store(true, std::memory_order_release);
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include "kd_tree.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <gsl/gsl_assert>
+#include <gsl/gsl_util>
+
+namespace {
+	constexpr std::size_t leaf_size = 8;
+}
+
+kd_tree::kd_tree(const std::vector<point_type>& points)
+	: points(points), nodes(points.size()) {
+	std::iota(nodes.begin(), nodes.end(), 0u);
+	build(0, nodes.size(), true);
+}
+
+void kd_tree::nearest(std::size_t index, std::size_t k, std::vector<unsigned>& result) const {
+	Expects(index < points.size());
+	Expects(k < points.size());
+	std::vector<candidate_type> heap;
+	heap.reserve(k);
+	search(0, nodes.size(), true, index, k, heap);
+	std::sort_heap(heap.begin(), heap.end());
+	for (const auto& candidate : heap) {
+		result.push_back(candidate.second);
+	}
+	Ensures(heap.size() == k);
+}
+
+void kd_tree::build(std::size_t first, std::size_t last, bool by_x) {
+	if (last - first <= leaf_size)
+		return;
+	const std::size_t middle = first + (last - first) / 2;
+	std::nth_element(nodes.begin() + first, nodes.begin() + middle, nodes.begin() + last, [&](unsigned lhs, unsigned rhs) {
+		const point_type& left = gsl::at(points, lhs);
+		const point_type& right = gsl::at(points, rhs);
+		return by_x ? left.first < right.first : left.second < right.second;
+	});
+	build(first, middle, !by_x);
+	build(middle + 1, last, !by_x);
+}
+
+void kd_tree::search(std::size_t first, std::size_t last, bool by_x, std::size_t index, std::size_t k, std::vector<candidate_type>& heap) const {
+	if (last - first <= leaf_size) {
+		for (std::size_t i = first; i < last; i++) {
+			offer(gsl::at(nodes, i), index, k, heap);
+		}
+		return;
+	}
+	const std::size_t middle = first + (last - first) / 2;
+	const unsigned node = gsl::at(nodes, middle);
+	offer(node, index, k, heap);
+	const point_type& query = gsl::at(points, index);
+	const point_type& split = gsl::at(points, node);
+	const double difference = by_x ? query.first - split.first : query.second - split.second;
+	const bool left_first = difference < 0.0;
+	if (left_first)
+		search(first, middle, !by_x, index, k, heap);
+	else
+		search(middle + 1, last, !by_x, index, k, heap);
+	const double worst = heap.size() < k ? std::numeric_limits<double>::infinity() : heap.front().first;
+	if (difference * difference < worst) {
+		if (left_first)
+			search(middle + 1, last, !by_x, index, k, heap);
+		else
+			search(first, middle, !by_x, index, k, heap);
+	}
+}
+
+void kd_tree::offer(unsigned node, std::size_t index, std::size_t k, std::vector<candidate_type>& heap) const {
+	if (node == index || k == 0)
+		return;
+	const point_type& query = gsl::at(points, index);
+	const point_type& point = gsl::at(points, node);
+	const double dx = query.first - point.first;
+	const double dy = query.second - point.second;
+	const candidate_type candidate(dx * dx + dy * dy, node);
+	if (heap.size() < k) {
+		heap.push_back(candidate);
+		std::push_heap(heap.begin(), heap.end());
+	} else if (candidate < heap.front()) {
+		std::pop_heap(heap.begin(), heap.end());
+		heap.back() = candidate;
+		std::push_heap(heap.begin(), heap.end());
+	}
+}
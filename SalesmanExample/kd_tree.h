@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SALESMAN_EXAMPLE_KD_TREE_H
+#define SALESMAN_EXAMPLE_KD_TREE_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class kd_tree {
+public:
+	using point_type = std::pair<double, double>;
+	explicit kd_tree(const std::vector<point_type>& points);
+	void nearest(std::size_t index, std::size_t k, std::vector<unsigned>& result) const;
+private:
+	using candidate_type = std::pair<double, unsigned>;
+	void build(std::size_t first, std::size_t last, bool by_x);
+	void search(std::size_t first, std::size_t last, bool by_x, std::size_t index, std::size_t k, std::vector<candidate_type>& heap) const;
+	void offer(unsigned node, std::size_t index, std::size_t k, std::vector<candidate_type>& heap) const;
+	std::vector<point_type> points;
+	std::vector<unsigned> nodes;
+};
+
+#endif
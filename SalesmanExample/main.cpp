@@ -22,22 +22,31 @@
 //
 ////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <charconv>
-#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <string>
 #include <fstream>
 #include <iostream>
+#include <memory_resource>
+#include <optional>
 #include <random>
 #include <vector>
 #include <gsl/gsl_util>
 #include <genetics.h>
+#include "candidate_list.h"
+#include "held_karp_bound.h"
 #include "path_evaluator.h"
 #include "path_merger.h"
 #include "path_mutator.h"
+#include "path_window_optimizer.h"
 #include "permutation.h"
 #include "permutation_generator.h"
+#include "tour_construction.h"
+#include "tour_hash.h"
 
-int main() {
+int main(int argc, char* argv[]) {
 	std::ios::sync_with_stdio(false);
 	std::ifstream in("matrix.txt");
 	std::size_t n;
@@ -48,41 +57,103 @@ int main() {
 			in >> cell;
 		}
 	}
-	std::mt19937_64 rand(std::chrono::high_resolution_clock::now().time_since_epoch().count());
-	using algorithm_type = genetic_algorithm<permutation, long long>;
+	std::ifstream in_pos("positions.txt");
+	std::vector<std::pair<double, double>> positions(n);
+	for (auto&& [x, y] : positions) {
+		in_pos >> x >> y;
+	}
+	const candidate_list candidates = nearest_neighbors(positions, 8);
+	const std::uint64_t seed = argc > 1 ? std::stoull(argv[1]) : std::random_device()();
+	std::cout << "Seed: " << seed << std::endl;
+	const random_stream_family streams(seed);
+	xoshiro256_star_star rand = streams(0);
+	using path_type = basic_permutation<std::uint16_t>;
+	using algorithm_type = genetic_algorithm<path_type, long long>;
 	algorithm_type::context_type context;
 	context.initial_population_size = 1000;
 	context.breeding_population_size = 100;
 	context.max_iterations = 100;
-	context.generator = permutation_generator(n, rand);
-	context.evaluator = path_evaluator(matrix);
+	context.generator = parallel_generator(streams(1), context.initial_population_size, tour_seeder<path_type, decltype(matrix)>(matrix, candidates, positions));
+	// To start from random tours instead, also try:
+	// context.generator = permutation_generator<xoshiro256_star_star, path_type>(n, rand);
+	telemetry_logger telemetry {std::greater<>()};
+	context.evaluator = telemetry.count_evaluations(path_evaluator(matrix));
+	context.bounded_evaluator = telemetry.count_evaluations(path_evaluator(matrix));
 	context.selector = elitist_selection<std::greater<>>();
+	context.streaming_selector = elitist_selection<std::greater<>>();
+	context.threshold_streaming = true;
 	// Also try:
 	// context.selector = roulette_wheel_selection(rand, [](long long x) { return std::exp(-x / 200.0); });
-	context.breeder = mutating_breeder(path_merger(rand),
-		chain_mutation {
-			mutate_with_probability(rand, 0.2, path_node_swapper(rand)),
-			mutate_with_probability(rand, 0.1, path_node_relocator(rand)),
-		}
-	);
+	// context.selector = tournament_selection(rand, 3, std::greater<>());
+	context.breeder = path_merger(rand);
+	context.mutator = chain_mutation {
+		batch_mutation(rand, 0.2, path_node_swapper(rand)),
+		batch_mutation(rand, 0.1, path_node_relocator(rand)),
+		batch_mutation(rand, 0.1, path_neighbor_inverter(rand, candidates)),
+	};
+	// To mutate on every core, with the same results for any number of threads, also try:
+	// task_random_bit_generator task_rand;
+	// context.mutator = chain_mutation {
+	// 	batch_mutation(rand, 0.2, path_node_swapper(task_rand), std::execution::par),
+	// 	batch_mutation(rand, 0.1, path_node_relocator(task_rand), std::execution::par),
+	// 	batch_mutation(rand, 0.1, path_neighbor_inverter(task_rand, candidates), std::execution::par),
+	// };
+	// To also reorder short stretches of tours optimally, add to the chain:
+	// batch_mutation(rand, 0.05, path_window_optimizer(rand, matrix, 8)),
 	context.comparator = std::greater<>();
-	std::ifstream in_pos("positions.txt");
-	std::vector<std::pair<double, double>> positions(n);
-	for (auto&& [x, y] : positions) {
-		in_pos >> x >> y;
+	context.fingerprint = canonical_tour_hash();
+	// To overlap breeding with evaluation on other threads, at the cost of reproducible runs, also try:
+	// context.evaluation_threads = std::thread::hardware_concurrency();
+	std::optional<held_karp_bound<decltype(matrix)>> lower_bound;
+	if (argc > 4) {
+		const double max_gap = std::stod(argv[4]) / 100;
+		lower_bound.emplace(matrix);
+		context.terminator = [&lower_bound, max_gap](long long length) {
+			return lower_bound->within(length, max_gap);
+		};
 	}
+	std::optional<mapped_file_resource> spill;
+	std::optional<budgeted_resource> budget;
+	if (argc > 2 && std::stoull(argv[2]) > 0) {
+		const std::size_t generation_size = std::max(context.initial_population_size, context.breeding_population_size * (context.breeding_population_size - 1) / 2);
+		spill.emplace("salesman.swap", 2 * generation_size * n * sizeof(path_type::value_type));
+		budget.emplace(std::stoull(argv[2]) << 20, *spill);
+		std::pmr::set_default_resource(&*budget);
+	}
+	std::optional<telemetry_server> endpoint;
+	if (argc > 3 && std::stoul(argv[3]) > 0)
+		endpoint.emplace(static_cast<std::uint16_t>(std::stoul(argv[3])), [&](std::ostream& out) {
+			telemetry.write_metrics(out);
+		});
+#ifdef LOGGING
+	counting_resource counting;
+	std::pmr::set_default_resource(&counting);
+	// populations stay on the ordinary heap when tours are spilled past a budget
+	if (!budget.has_value())
+		context.memory_resource = &counting;
+#endif
+	const auto restore_default_resource = gsl::finally([] {
+		std::pmr::set_default_resource(nullptr);
+	});
 	algorithm_type algorithm(context);
 #ifdef LOGGING
 	std::ofstream out_log("salesman.log");
 	default_logger logger(out_log);
+	allocation_logger allocations(counting, out_log);
+	performance_counter_logger counters(out_log);
+	trace_recorder recorder;
+	trace_recorder::install(&recorder);
+	trace_logger tracer(recorder);
 #endif
 	for (int i = 0; i < 10; i++) {
-		const auto result = algorithm(
+		const auto result = algorithm(telemetry
 #ifdef LOGGING
-			logger
+			, logger, allocations, counters, tracer
 #endif
 		);
 		std::cout << "Best path found has length " << result.rating() << ":\n" << result.value() << std::endl;
+		if (lower_bound.has_value())
+			std::cout << "Lower bound: " << lower_bound->lower_bound() << std::endl;
 		char filename[] = "cities_0.log";
 		std::to_chars(&filename[7], &filename[8], i);
 		std::ofstream out_pos(filename);
@@ -93,5 +164,11 @@ int main() {
 		const auto& [x, y] = gsl::at(positions, result.value().front());
 		out_pos << x << ' ' << y << '\n';
 	}
+#ifdef LOGGING
+	counters.write_totals();
+	trace_recorder::install(nullptr);
+	std::ofstream out_trace("salesman.trace.json");
+	recorder.write(out_trace);
+#endif
 	return 0;
 }
@@ -25,10 +25,13 @@
 #ifndef SALESMAN_EXAMPLE_PATH_EVALUATOR_H
 #define SALESMAN_EXAMPLE_PATH_EVALUATOR_H
 
+#include <cstddef>
 #include <functional>
+#include <iterator>
 #include <numeric>
 #include <gsl/gsl_assert>
 #include "permutation.h"
+#include "tour.h"
 
 template<class Matrix>
 class path_evaluator {
@@ -37,8 +40,13 @@ public:
 	using row_type = typename matrix_type::value_type;
 	using value_type = typename row_type::value_type;
 	explicit path_evaluator(const matrix_type& matrix);
-	value_type operator()(const permutation& perm) const;
+	template<class Permutation>
+	value_type operator()(const Permutation& perm) const;
+	template<class Permutation>
+	value_type operator()(const Permutation& perm, value_type cutoff) const;
+	value_type operator()(const tour& path) const;
 private:
+	static constexpr std::size_t cutoff_stride = 8;
 	matrix_type matrix;
 };
 
@@ -47,13 +55,55 @@ inline path_evaluator<Matrix>::path_evaluator(const matrix_type& matrix)
 	: matrix(matrix) {}
 
 template<class Matrix>
-inline auto path_evaluator<Matrix>::operator()(const permutation& perm) const -> value_type {
+template<class Permutation>
+inline auto path_evaluator<Matrix>::operator()(const Permutation& perm) const -> value_type {
 	Expects(perm.size() == matrix.size());
 	Expects(perm.size() > 0);
-	const auto distance = [this](unsigned dest, unsigned src) {
+	const auto distance = [this](std::size_t dest, std::size_t src) {
 		return gsl::at(gsl::at(matrix, src), dest);
 	};
 	return std::inner_product(std::next(perm.begin()), perm.end(), perm.begin(), distance(perm.front(), perm.back()), std::plus<>(), distance);
 }
 
+/// Length of the path, or of a prefix of it once that is already longer than \a cutoff
+/**
+The running length is compared with the cutoff every \c cutoff_stride
+edges, which keeps the inner loop free of branches. Since no distance
+is negative, the running length only grows, so a prefix longer than the
+cutoff proves the whole path is too. This assumes shorter paths are
+better, as with \c std::greater as the comparator of the algorithm.
+*/
+template<class Matrix>
+template<class Permutation>
+inline auto path_evaluator<Matrix>::operator()(const Permutation& perm, value_type cutoff) const -> value_type {
+	Expects(perm.size() == matrix.size());
+	Expects(perm.size() > 0);
+	const auto distance = [this](std::size_t dest, std::size_t src) {
+		return gsl::at(gsl::at(matrix, src), dest);
+	};
+	value_type result = distance(perm.front(), perm.back());
+	auto first = perm.begin();
+	while (std::size_t(std::distance(first, perm.end())) > cutoff_stride) {
+		const auto last = std::next(first, cutoff_stride);
+		result = std::inner_product(std::next(first), std::next(last), first, result, std::plus<>(), distance);
+		if (result > cutoff)
+			return result;
+		first = last;
+	}
+	return std::inner_product(std::next(first), perm.end(), first, result, std::plus<>(), distance);
+}
+
+template<class Matrix>
+inline auto path_evaluator<Matrix>::operator()(const tour& path) const -> value_type {
+	Expects(path.size() == matrix.size());
+	Expects(path.size() > 0);
+	unsigned src = path.at(path.size() - 1);
+	value_type result = value_type();
+	path.for_each([&](unsigned dest) {
+		result += gsl::at(gsl::at(matrix, src), dest);
+		src = dest;
+	});
+	return result;
+}
+
 #endif
@@ -28,6 +28,9 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
 #include <stack>
 #include <utility>
 #include <vector>
@@ -36,36 +39,54 @@
 #include <repeat.h>
 #include "disjoint_set_data_structure.h"
 #include "permutation.h"
+#include "tour.h"
 
+/// Crossover keeping the edges common to both parents and completing the tour with edges of either parent
+/**
+The working buffers come from a pool kept between calls and shared by the
+copies of the merger, so once the pool has grown, merging allocates only
+the child itself. Like the random engine, a merger and its copies must be
+used by one thread at a time.
+*/
 template<class UniformRandomBitGenerator>
 class path_merger {
 public:
-	explicit path_merger(UniformRandomBitGenerator& g) noexcept;
-	permutation operator()(const permutation& lhs, const permutation& rhs);
+	explicit path_merger(UniformRandomBitGenerator& g);
+	template<class Permutation>
+	Permutation operator()(const Permutation& lhs, const Permutation& rhs);
+	tour operator()(const tour& lhs, const tour& rhs);
 private:
-	using edge_type = std::pair<unsigned, unsigned>;
-	using edge_vector = std::vector<edge_type>;
-	edge_vector to_edges(const permutation& perm) const;
-	permutation to_permutation(const edge_vector& edges) const;
+	template<class Index>
+	using edge_type = std::pair<Index, Index>;
+	template<class Index>
+	using edge_vector = std::pmr::vector<edge_type<Index>>;
+	template<class Permutation>
+	edge_vector<typename Permutation::value_type> to_edges(const Permutation& perm) const;
+	template<class Permutation>
+	Permutation to_permutation(const edge_vector<typename Permutation::value_type>& edges) const;
 	UniformRandomBitGenerator& rand;
+	std::shared_ptr<std::pmr::unsynchronized_pool_resource> scratch;
 };
 
 template<class UniformRandomBitGenerator>
-path_merger<UniformRandomBitGenerator>::path_merger(UniformRandomBitGenerator& g) noexcept
-	: rand(g) {}
+path_merger<UniformRandomBitGenerator>::path_merger(UniformRandomBitGenerator& g)
+	: rand(g), scratch(std::make_shared<std::pmr::unsynchronized_pool_resource>()) {}
 
 template<class UniformRandomBitGenerator>
-permutation path_merger<UniformRandomBitGenerator>::operator()(const permutation& lhs, const permutation& rhs) {
+template<class Permutation>
+Permutation path_merger<UniformRandomBitGenerator>::operator()(const Permutation& lhs, const Permutation& rhs) {
+	using index_type = typename Permutation::value_type;
+	using edge = edge_type<index_type>;
 	Expects(lhs.size() == rhs.size());
 	Expects(lhs.size() > 0);
 	const std::size_t size = lhs.size();
-	edge_vector lhs_edges = to_edges(lhs);
-	edge_vector rhs_edges = to_edges(rhs);
-	edge_vector result_edges;
+	edge_vector<index_type> lhs_edges = to_edges(lhs);
+	edge_vector<index_type> rhs_edges = to_edges(rhs);
+	edge_vector<index_type> result_edges(scratch.get());
 	result_edges.reserve(size);
 	std::set_intersection(lhs_edges.begin(), lhs_edges.end(), rhs_edges.begin(), rhs_edges.end(), std::back_inserter(result_edges));
-	disjoint_set_data_structure components(size);
-	std::vector<unsigned> missing_edges(size, 2);
+	disjoint_set_data_structure components(size, scratch.get());
+	std::pmr::vector<unsigned> missing_edges(size, 2, scratch.get());
 	for (const auto& [left, right] : result_edges) {
 		components.merge(left, right);
 		gsl::at(missing_edges, left)--;
@@ -73,11 +94,11 @@ permutation path_merger<UniformRandomBitGenerator>::operator()(const permutation
 	}
 	std::shuffle(lhs_edges.begin(), lhs_edges.end(), rand);
 	std::shuffle(rhs_edges.begin(), rhs_edges.end(), rand);
-	gsl::span<edge_type> spans[2] {lhs_edges, rhs_edges};
-	while (!std::all_of(std::begin(spans), std::end(spans), std::mem_fn(&gsl::span<edge_type>::empty))) {
+	gsl::span<edge> spans[2] {lhs_edges, rhs_edges};
+	while (!std::all_of(std::begin(spans), std::end(spans), std::mem_fn(&gsl::span<edge>::empty))) {
 		for (auto&& span : spans) {
-			auto it = std::find_if(span.begin(), span.end(), [&](const edge_type& edge) {
-				const auto& [lhs, rhs] = edge;
+			auto it = std::find_if(span.begin(), span.end(), [&](const edge& e) {
+				const auto& [lhs, rhs] = e;
 				return gsl::at(missing_edges, lhs) && gsl::at(missing_edges, rhs) && components.find(lhs) != components.find(rhs);
 			});
 			if (it != span.end()) {
@@ -90,38 +111,46 @@ permutation path_merger<UniformRandomBitGenerator>::operator()(const permutation
 			span = span.subspan(it - span.begin());
 		}
 	}
-	std::stack<unsigned, std::vector<unsigned>> s;
-	for (unsigned i = 0; i < size; i++) {
+	std::stack<index_type, std::pmr::vector<index_type>> s(std::pmr::vector<index_type>(scratch.get()));
+	for (std::size_t i = 0; i < size; i++) {
 		repeat(gsl::at(missing_edges, i), [&] {
-			if (!s.empty() && components.find(s.top()) != components.find(i)) {
-				const unsigned& left = s.top();
-				const unsigned& right = i;
+			const index_type right = gsl::narrow_cast<index_type>(i);
+			if (!s.empty() && components.find(s.top()) != components.find(right)) {
+				const index_type left = s.top();
 				result_edges.emplace_back(left, right);
 				components.merge(left, right);
 				gsl::at(missing_edges, left)--;
 				gsl::at(missing_edges, right)--;
 				s.pop();
 			} else {
-				s.push(i);
+				s.push(right);
 			}
 		});
 	}
 	if (!s.empty()) {
-		const unsigned left = s.top();
+		const index_type left = s.top();
 		s.pop();
-		const unsigned& right = s.top();
+		const index_type& right = s.top();
 		result_edges.emplace_back(left, right);
 	}
 	Ensures(result_edges.size() == lhs.size());
-	return to_permutation(result_edges);
+	return to_permutation<Permutation>(result_edges);
 }
 
 template<class UniformRandomBitGenerator>
-auto path_merger<UniformRandomBitGenerator>::to_edges(const permutation& perm) const -> edge_vector {
+tour path_merger<UniformRandomBitGenerator>::operator()(const tour& lhs, const tour& rhs) {
+	return tour((*this)(lhs.to_permutation(), rhs.to_permutation()));
+}
+
+template<class UniformRandomBitGenerator>
+template<class Permutation>
+auto path_merger<UniformRandomBitGenerator>::to_edges(const Permutation& perm) const -> edge_vector<typename Permutation::value_type> {
+	using index_type = typename Permutation::value_type;
 	Expects(perm.size() > 0);
-	edge_vector result {std::minmax({perm.front(), perm.back()})};
+	edge_vector<index_type> result(scratch.get());
 	result.reserve(perm.size());
-	std::transform(std::next(perm.begin()), perm.end(), perm.begin(), std::inserter(result, result.end()), [](unsigned lhs, unsigned rhs) {
+	result.push_back(std::minmax({perm.front(), perm.back()}));
+	std::transform(std::next(perm.begin()), perm.end(), perm.begin(), std::inserter(result, result.end()), [](index_type lhs, index_type rhs) {
 		return std::minmax({lhs, rhs});
 	});
 	std::sort(result.begin(), result.end());
@@ -130,24 +159,29 @@ auto path_merger<UniformRandomBitGenerator>::to_edges(const permutation& perm) c
 }
 
 template<class UniformRandomBitGenerator>
-permutation path_merger<UniformRandomBitGenerator>::to_permutation(const edge_vector& edges) const {
+template<class Permutation>
+Permutation path_merger<UniformRandomBitGenerator>::to_permutation(const edge_vector<typename Permutation::value_type>& edges) const {
+	using index_type = typename Permutation::value_type;
 	Expects(edges.size() > 0);
 	const std::size_t size = edges.size();
-	std::vector<std::vector<unsigned>> graph(size);
-	for (auto&& node : graph) {
-		node.reserve(2);
-	}
+	constexpr index_type none = std::numeric_limits<index_type>::max();
+	Expects(size <= none);
+	std::pmr::vector<edge_type<index_type>> graph(size, {none, none}, scratch.get());
+	const auto link = [&](index_type from, index_type to) {
+		auto& [first, second] = gsl::at(graph, from);
+		(first == none ? first : second) = to;
+	};
 	for (const auto& [lhs, rhs] : edges) {
-		gsl::at(graph, lhs).push_back(rhs);
-		gsl::at(graph, rhs).push_back(lhs);
+		link(lhs, rhs);
+		link(rhs, lhs);
 	}
-	permutation result(size);
-	unsigned prev = 0;
-	unsigned cur = graph.front().front();
-	std::for_each(std::next(result.begin()), result.end(), [&](unsigned& element) {
+	Permutation result(size);
+	index_type prev = 0;
+	index_type cur = graph.front().first;
+	std::for_each(std::next(result.begin()), result.end(), [&](index_type& element) {
 		element = cur;
-		const auto& node = gsl::at(graph, cur);
-		unsigned next = node.front() == prev ? node.back() : node.front();
+		const auto& [first, second] = gsl::at(graph, cur);
+		index_type next = first == prev ? second : first;
 		prev = cur;
 		cur = next;
 	});
@@ -29,14 +29,18 @@
 #include <functional>
 #include <iterator>
 #include <random>
-#include <vector>
+#include <gsl/gsl_assert>
+#include "candidate_list.h"
 #include "permutation.h"
+#include "tour.h"
 
 template<class UniformRandomBitGenerator>
 class path_node_swapper {
 public:
 	explicit path_node_swapper(UniformRandomBitGenerator& g) noexcept;
-	void operator()(permutation& perm);
+	template<class Permutation>
+	void operator()(Permutation& perm);
+	void operator()(tour& path);
 private:
 	UniformRandomBitGenerator& rand;
 };
@@ -46,19 +50,35 @@ inline path_node_swapper<UniformRandomBitGenerator>::path_node_swapper(UniformRa
 	: rand(g) {}
 
 template<class UniformRandomBitGenerator>
-inline void path_node_swapper<UniformRandomBitGenerator>::operator()(permutation& perm) {
+template<class Permutation>
+inline void path_node_swapper<UniformRandomBitGenerator>::operator()(Permutation& perm) {
 	Expects(perm.size() > 0);
-	std::vector<std::reference_wrapper<permutation::value_type>> sample;
-	sample.reserve(2);
-	std::sample(perm.begin(), perm.end(), std::back_inserter(sample), 2, rand);
-	std::swap(sample.front().get(), sample.back().get());
+	std::reference_wrapper<typename Permutation::value_type> sample[2] {perm.front(), perm.front()};
+	const auto last = std::sample(perm.begin(), perm.end(), std::begin(sample), 2, rand);
+	std::swap(sample[0].get(), std::prev(last)->get());
+}
+
+template<class UniformRandomBitGenerator>
+inline void path_node_swapper<UniformRandomBitGenerator>::operator()(tour& path) {
+	Expects(path.size() > 0);
+	if (path.size() < 2)
+		return;
+	std::uniform_int_distribution<std::size_t> first_distribution(0, path.size() - 1);
+	std::uniform_int_distribution<std::size_t> second_distribution(0, path.size() - 2);
+	const std::size_t first = first_distribution(rand);
+	std::size_t second = second_distribution(rand);
+	if (second >= first)
+		second++;
+	path.swap(first, second);
 }
 
 template<class UniformRandomBitGenerator>
 class path_node_relocator {
 public:
 	explicit path_node_relocator(UniformRandomBitGenerator& g) noexcept;
-	void operator()(permutation& perm) const;
+	template<class Permutation>
+	void operator()(Permutation& perm) const;
+	void operator()(tour& path) const;
 private:
 	UniformRandomBitGenerator& rand;
 };
@@ -68,7 +88,8 @@ inline path_node_relocator<UniformRandomBitGenerator>::path_node_relocator(Unifo
 	: rand(g) {}
 
 template<class UniformRandomBitGenerator>
-inline void path_node_relocator<UniformRandomBitGenerator>::operator()(permutation& perm) const {
+template<class Permutation>
+inline void path_node_relocator<UniformRandomBitGenerator>::operator()(Permutation& perm) const {
 	Expects(perm.size() > 0);
 	std::uniform_int_distribution<std::size_t> distribution(0, perm.size());
 	const auto left = perm.begin() + distribution(rand);
@@ -79,4 +100,102 @@ inline void path_node_relocator<UniformRandomBitGenerator>::operator()(permutati
 		std::rotate(right, std::prev(left), left);
 }
 
+template<class UniformRandomBitGenerator>
+inline void path_node_relocator<UniformRandomBitGenerator>::operator()(tour& path) const {
+	Expects(path.size() > 0);
+	std::uniform_int_distribution<std::size_t> distribution(0, path.size());
+	const std::size_t left = distribution(rand);
+	const std::size_t right = distribution(rand);
+	if (left < right)
+		path.relocate(left, right - 1);
+	else if (left > right)
+		path.relocate(left - 1, right);
+}
+
+template<class UniformRandomBitGenerator>
+class path_segment_reverser {
+public:
+	explicit path_segment_reverser(UniformRandomBitGenerator& g) noexcept;
+	template<class Permutation>
+	void operator()(Permutation& perm) const;
+	void operator()(tour& path) const;
+private:
+	UniformRandomBitGenerator& rand;
+};
+
+template<class UniformRandomBitGenerator>
+inline path_segment_reverser<UniformRandomBitGenerator>::path_segment_reverser(UniformRandomBitGenerator& g) noexcept
+	: rand(g) {}
+
+template<class UniformRandomBitGenerator>
+template<class Permutation>
+inline void path_segment_reverser<UniformRandomBitGenerator>::operator()(Permutation& perm) const {
+	Expects(perm.size() > 0);
+	std::uniform_int_distribution<std::size_t> distribution(0, perm.size());
+	std::size_t first = distribution(rand);
+	std::size_t last = distribution(rand);
+	if (first > last)
+		std::swap(first, last);
+	std::reverse(perm.begin() + first, perm.begin() + last);
+}
+
+template<class UniformRandomBitGenerator>
+inline void path_segment_reverser<UniformRandomBitGenerator>::operator()(tour& path) const {
+	Expects(path.size() > 0);
+	std::uniform_int_distribution<std::size_t> distribution(0, path.size());
+	std::size_t first = distribution(rand);
+	std::size_t last = distribution(rand);
+	if (first > last)
+		std::swap(first, last);
+	path.reverse(first, last);
+}
+
+template<class UniformRandomBitGenerator>
+class path_neighbor_inverter {
+public:
+	path_neighbor_inverter(UniformRandomBitGenerator& g, const candidate_list& candidates) noexcept;
+	template<class Permutation>
+	void operator()(Permutation& perm) const;
+	void operator()(tour& path) const;
+private:
+	UniformRandomBitGenerator& rand;
+	const candidate_list& candidates;
+};
+
+template<class UniformRandomBitGenerator>
+inline path_neighbor_inverter<UniformRandomBitGenerator>::path_neighbor_inverter(UniformRandomBitGenerator& g, const candidate_list& candidates) noexcept
+	: rand(g), candidates(candidates) {}
+
+template<class UniformRandomBitGenerator>
+template<class Permutation>
+inline void path_neighbor_inverter<UniformRandomBitGenerator>::operator()(Permutation& perm) const {
+	Expects(perm.size() == candidates.size());
+	if (candidates.width() == 0)
+		return;
+	std::uniform_int_distribution<std::size_t> position_distribution(0, perm.size() - 1);
+	std::uniform_int_distribution<std::ptrdiff_t> neighbor_distribution(0, candidates.width() - 1);
+	const auto city = perm.begin() + position_distribution(rand);
+	const unsigned target = candidates[*city][neighbor_distribution(rand)];
+	const auto neighbor = std::find(perm.begin(), perm.end(), target);
+	if (city < neighbor)
+		std::reverse(std::next(city), std::next(neighbor));
+	else
+		std::reverse(neighbor, city);
+}
+
+template<class UniformRandomBitGenerator>
+inline void path_neighbor_inverter<UniformRandomBitGenerator>::operator()(tour& path) const {
+	Expects(path.size() == candidates.size());
+	if (candidates.width() == 0)
+		return;
+	std::uniform_int_distribution<std::size_t> position_distribution(0, path.size() - 1);
+	std::uniform_int_distribution<std::ptrdiff_t> neighbor_distribution(0, candidates.width() - 1);
+	const std::size_t city = position_distribution(rand);
+	const std::size_t neighbor = path.position(candidates[path.at(city)][neighbor_distribution(rand)]);
+	if (city < neighbor)
+		path.reverse(city + 1, neighbor + 1);
+	else
+		path.reverse(neighbor, city);
+}
+
 #endif
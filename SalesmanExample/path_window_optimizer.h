@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SALESMAN_EXAMPLE_PATH_WINDOW_OPTIMIZER_H
+#define SALESMAN_EXAMPLE_PATH_WINDOW_OPTIMIZER_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+#include <gsl/gsl_assert>
+#include <gsl/gsl_util>
+#include "tour.h"
+
+/// Mutator putting a random window of consecutive cities in the best order between its neighbours
+/**
+The cities of the window are reordered by the Held-Karp dynamic program
+over subsets, keeping the cities just before and after the window in
+place, and the new order is kept only if it is shorter. Each call takes
+time proportional to 2^k k^2 for a window of k cities, whatever the
+number of cities, so windows of 8 to 12 cities are cheap enough to be
+mutated often.
+
+The table of partial path lengths, of 2^k k entries, is allocated once
+per thread and reused, so calls allocate no memory and may run concurrently as long as
+the generator can be shared. Its rows are contiguous, with the lengths
+of paths not ending in the subset set to a sentinel, so the innermost
+minimum has no branches and is left to the compiler to vectorize.
+*/
+template<class UniformRandomBitGenerator, class Matrix>
+class path_window_optimizer {
+public:
+	using matrix_type = Matrix;
+	using row_type = typename matrix_type::value_type;
+	using value_type = typename row_type::value_type;
+	static constexpr std::size_t max_window = 16;
+	path_window_optimizer(UniformRandomBitGenerator& g, const matrix_type& matrix, std::size_t window = 8);
+	template<class Permutation>
+	void operator()(Permutation& perm) const;
+	void operator()(tour& path) const;
+private:
+	static constexpr value_type unreachable = std::numeric_limits<value_type>::max() / 4;
+	struct workspace {
+		std::array<value_type, max_window * max_window> into;
+		std::array<value_type, max_window> from_first;
+		std::array<value_type, max_window> to_last;
+		std::array<unsigned, max_window> order;
+		std::vector<value_type> lengths;
+	};
+	workspace& local_workspace() const;
+	template<class City>
+	bool optimize(workspace& work, City first, const City* cities, City last, std::size_t size) const;
+	value_type distance(std::size_t src, std::size_t dest) const;
+	UniformRandomBitGenerator& rand;
+	const matrix_type& matrix;
+	std::size_t window;
+};
+
+template<class UniformRandomBitGenerator, class Matrix>
+inline path_window_optimizer<UniformRandomBitGenerator, Matrix>::path_window_optimizer(UniformRandomBitGenerator& g, const matrix_type& matrix, std::size_t window)
+	: rand(g), matrix(matrix), window(window) {
+	Expects(window >= 2 && window <= max_window);
+}
+
+template<class UniformRandomBitGenerator, class Matrix>
+template<class Permutation>
+inline void path_window_optimizer<UniformRandomBitGenerator, Matrix>::operator()(Permutation& perm) const {
+	Expects(perm.size() == matrix.size());
+	Expects(perm.size() > 0);
+	const std::size_t n = perm.size();
+	if (n < 4)
+		return;
+	const std::size_t size = std::min(window, n - 2);
+	std::uniform_int_distribution<std::size_t> position_distribution(0, n - 1);
+	const std::size_t start = position_distribution(rand);
+	std::array<typename Permutation::value_type, max_window> cities;
+	for (std::size_t i = 0; i < size; i++) {
+		cities[i] = perm[(start + 1 + i) % n];
+	}
+	workspace& work = local_workspace();
+	if (!optimize(work, perm[start], cities.data(), perm[(start + size + 1) % n], size))
+		return;
+	for (std::size_t i = 0; i < size; i++) {
+		perm[(start + 1 + i) % n] = cities[work.order[i]];
+	}
+}
+
+template<class UniformRandomBitGenerator, class Matrix>
+inline void path_window_optimizer<UniformRandomBitGenerator, Matrix>::operator()(tour& path) const {
+	Expects(path.size() == matrix.size());
+	Expects(path.size() > 0);
+	const std::size_t n = path.size();
+	if (n < 4)
+		return;
+	const std::size_t size = std::min(window, n - 2);
+	std::uniform_int_distribution<std::size_t> position_distribution(0, n - 1);
+	const std::size_t start = position_distribution(rand);
+	std::array<tour::value_type, max_window> cities;
+	for (std::size_t i = 0; i < size; i++) {
+		cities[i] = path.at((start + 1 + i) % n);
+	}
+	workspace& work = local_workspace();
+	if (!optimize(work, path.at(start), cities.data(), path.at((start + size + 1) % n), size))
+		return;
+	for (std::size_t i = 0; i < size; i++) {
+		path.swap((start + 1 + i) % n, path.position(cities[work.order[i]]));
+	}
+}
+
+template<class UniformRandomBitGenerator, class Matrix>
+inline auto path_window_optimizer<UniformRandomBitGenerator, Matrix>::local_workspace() const -> workspace& {
+	thread_local workspace work;
+	const std::size_t capacity = (std::size_t(1) << window) * window;
+	if (work.lengths.size() < capacity)
+		work.lengths.resize(capacity);
+	return work;
+}
+
+/// Finds the shortest path from \a first through \a cities to \a last
+/**
+Returns whether it is shorter than the path visiting the cities in their
+current order, which is then replaced in \c work.order by the indices of
+the cities in their new order.
+*/
+template<class UniformRandomBitGenerator, class Matrix>
+template<class City>
+inline bool path_window_optimizer<UniformRandomBitGenerator, Matrix>::optimize(workspace& work, City first, const City* cities, City last, std::size_t size) const {
+	value_type current = distance(first, cities[0]) + distance(cities[size - 1], last);
+	for (std::size_t i = 0; i < size; i++) {
+		work.from_first[i] = distance(first, cities[i]);
+		work.to_last[i] = distance(cities[i], last);
+		for (std::size_t j = 0; j < size; j++) {
+			work.into[i * size + j] = distance(cities[j], cities[i]);
+		}
+		if (i > 0)
+			current += distance(cities[i - 1], cities[i]);
+	}
+	// lengths[subset * size + i] is the length of the shortest path from the
+	// first city through the subset, ending in its i-th city
+	value_type* const lengths = work.lengths.data();
+	const std::size_t full = (std::size_t(1) << size) - 1;
+	for (std::size_t subset = 1; subset <= full; subset++) {
+		value_type* const row = lengths + subset * size;
+		for (std::size_t i = 0; i < size; i++) {
+			const std::size_t rest = subset & ~(std::size_t(1) << i);
+			if (rest == subset) {
+				row[i] = unreachable;
+			} else if (rest == 0) {
+				row[i] = work.from_first[i];
+			} else {
+				const value_type* const previous = lengths + rest * size;
+				const value_type* const into = work.into.data() + i * size;
+				value_type best = unreachable;
+				for (std::size_t j = 0; j < size; j++) {
+					best = std::min(best, previous[j] + into[j]);
+				}
+				row[i] = best;
+			}
+		}
+	}
+	const value_type* row = lengths + full * size;
+	std::size_t end = 0;
+	for (std::size_t i = 1; i < size; i++) {
+		if (row[i] + work.to_last[i] < row[end] + work.to_last[end])
+			end = i;
+	}
+	if (!(row[end] + work.to_last[end] < current))
+		return false;
+	std::size_t subset = full;
+	for (std::size_t position = size; position-- > 0;) {
+		work.order[position] = unsigned(end);
+		subset &= ~(std::size_t(1) << end);
+		if (subset == 0)
+			break;
+		const value_type* const previous = lengths + subset * size;
+		const value_type* const into = work.into.data() + end * size;
+		std::size_t next = 0;
+		for (std::size_t j = 1; j < size; j++) {
+			if (previous[j] + into[j] < previous[next] + into[next])
+				next = j;
+		}
+		end = next;
+	}
+	return true;
+}
+
+template<class UniformRandomBitGenerator, class Matrix>
+inline auto path_window_optimizer<UniformRandomBitGenerator, Matrix>::distance(std::size_t src, std::size_t dest) const -> value_type {
+	return gsl::at(gsl::at(matrix, src), dest);
+}
+
+#endif
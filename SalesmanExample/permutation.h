@@ -25,22 +25,56 @@
 #ifndef SALESMAN_EXAMPLE_PERMUTATION_H
 #define SALESMAN_EXAMPLE_PERMUTATION_H
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <memory_resource>
 #include <ostream>
+#include <type_traits>
 #include <vector>
+#include "fixed_capacity_vector.h"
 
-using permutation = std::vector<unsigned>;
+constexpr std::size_t dynamic_capacity = 0;
 
-template<class CharT, class Traits>
-std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const permutation& perm) {
+/// A permutation of city indices of type \a Index
+/**
+Stored inline, without a separate heap block, when \a Capacity is not
+\c dynamic_capacity, and in a block of the default memory resource
+otherwise. A narrow \a Index such as \c std::uint16_t halves
+the size of a specimen compared with the default \c permutation.
+*/
+/// Tells whether \a Index is an unsigned integer type meant for city indices, as opposed to \c bool or a character type
+template<class Index>
+constexpr bool is_city_index_v = std::is_same_v<Index, unsigned short>
+	|| std::is_same_v<Index, unsigned>
+	|| std::is_same_v<Index, unsigned long>
+	|| std::is_same_v<Index, unsigned long long>;
+
+template<class Index, std::size_t Capacity = dynamic_capacity>
+using basic_permutation = std::conditional_t<Capacity == dynamic_capacity, std::pmr::vector<Index>, fixed_capacity_vector<Index, Capacity>>;
+
+using permutation = basic_permutation<unsigned>;
+
+template<class CharT, class Traits, class Permutation>
+std::basic_ostream<CharT, Traits>& write_permutation(std::basic_ostream<CharT, Traits>& os, const Permutation& perm) {
 	os << '[';
 	if (!perm.empty()) {
-		std::for_each(perm.begin(), std::prev(perm.end()), [&](unsigned element) {
-			os << element << ',';
+		std::for_each(perm.begin(), std::prev(perm.end()), [&](auto element) {
+			os << +element << ',';
 		});
-		os << perm.back();
+		os << +perm.back();
 	}
 	return os << ']';
 }
 
+template<class CharT, class Traits, class Index, class = std::enable_if_t<is_city_index_v<Index>>>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const std::pmr::vector<Index>& perm) {
+	return write_permutation(os, perm);
+}
+
+template<class CharT, class Traits, class Index, std::size_t Capacity>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const fixed_capacity_vector<Index, Capacity>& perm) {
+	return write_permutation(os, perm);
+}
+
 #endif
@@ -28,28 +28,33 @@
 #include <algorithm>
 #include <cstddef>
 #include <functional>
+#include <limits>
 #include <numeric>
 #include <random>
+#include <gsl/gsl_assert>
 #include "permutation.h"
 
-template<class UniformRandomBitGenerator>
+template<class UniformRandomBitGenerator, class Permutation = permutation>
 class permutation_generator {
 public:
+	using permutation_type = Permutation;
 	permutation_generator(std::size_t n, UniformRandomBitGenerator& g) noexcept;
-	permutation operator()();
+	permutation_type operator()();
 private:
 	std::size_t size;
 	UniformRandomBitGenerator& rand;
 };
 
-template<class UniformRandomBitGenerator>
-inline permutation_generator<UniformRandomBitGenerator>::permutation_generator(std::size_t n, UniformRandomBitGenerator& g) noexcept
+template<class UniformRandomBitGenerator, class Permutation>
+inline permutation_generator<UniformRandomBitGenerator, Permutation>::permutation_generator(std::size_t n, UniformRandomBitGenerator& g) noexcept
 	: size(n), rand(g) {}
 
-template<class UniformRandomBitGenerator>
-inline permutation permutation_generator<UniformRandomBitGenerator>::operator()() {
-	permutation result(size);
-	std::iota(result.begin(), result.end(), 0);
+template<class UniformRandomBitGenerator, class Permutation>
+inline auto permutation_generator<UniformRandomBitGenerator, Permutation>::operator()() -> permutation_type {
+	using index_type = typename permutation_type::value_type;
+	Expects(size == 0 || size - 1 <= std::numeric_limits<index_type>::max());
+	permutation_type result(size);
+	std::iota(result.begin(), result.end(), index_type());
 	std::shuffle(result.begin(), result.end(), rand);
 	return result;
 }
@@ -0,0 +1,216 @@
+#include "tour.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include <gsl/gsl_util>
+
+namespace {
+	unsigned hash_priority(std::uint32_t x) noexcept {
+		x = (x ^ (x >> 16)) * 0x7FEB352Du;
+		x = (x ^ (x >> 15)) * 0x846CA68Bu;
+		return x ^ (x >> 16);
+	}
+}
+
+tour::tour(const permutation& perm)
+	: nodes(perm.size()) {
+	std::vector<value_type> spine;
+	for (value_type city : perm) {
+		node& current = gsl::at(nodes, city);
+		Expects(current.priority == 0);
+		current.priority = hash_priority(city) | 1u;
+		value_type last = none;
+		while (!spine.empty() && nodes[spine.back()].priority < current.priority) {
+			last = spine.back();
+			update(last);
+			spine.pop_back();
+		}
+		current.left = last;
+		if (!spine.empty())
+			nodes[spine.back()].right = city;
+		spine.push_back(city);
+	}
+	if (!spine.empty())
+		root = spine.front();
+	while (!spine.empty()) {
+		update(spine.back());
+		spine.pop_back();
+	}
+	Ensures(subtree_size(root) == perm.size());
+}
+
+std::size_t tour::size() const noexcept {
+	return nodes.size();
+}
+
+bool tour::empty() const noexcept {
+	return nodes.empty();
+}
+
+auto tour::at(std::size_t index) const -> value_type {
+	Expects(index < size());
+	value_type current = root;
+	bool reversed = false;
+	while (true) {
+		const node& n = nodes[current];
+		reversed ^= n.reversed;
+		const value_type left = reversed ? n.right : n.left;
+		const std::size_t left_size = subtree_size(left);
+		if (index == left_size)
+			return current;
+		if (index < left_size) {
+			current = left;
+		} else {
+			index -= left_size + 1;
+			current = reversed ? n.left : n.right;
+		}
+	}
+}
+
+std::size_t tour::position(value_type city) const {
+	Expects(city < size());
+	bool reversed = false;
+	for (value_type index = city; index != none; index = nodes[index].parent) {
+		reversed ^= nodes[index].reversed;
+	}
+	const node& target = nodes[city];
+	std::size_t result = subtree_size(reversed ? target.right : target.left);
+	for (value_type index = city; nodes[index].parent != none; index = nodes[index].parent) {
+		reversed ^= nodes[index].reversed;
+		const node& parent = nodes[nodes[index].parent];
+		const value_type left = reversed ? parent.right : parent.left;
+		if (left != index)
+			result += subtree_size(left) + 1;
+	}
+	return result;
+}
+
+auto tour::next(value_type city) const -> value_type {
+	const std::size_t index = position(city) + 1;
+	return at(index == size() ? 0 : index);
+}
+
+auto tour::prev(value_type city) const -> value_type {
+	const std::size_t index = position(city);
+	return at(index == 0 ? size() - 1 : index - 1);
+}
+
+bool tour::between(value_type first, value_type middle, value_type last) const {
+	const std::size_t a = position(first);
+	const std::size_t b = position(middle);
+	const std::size_t c = position(last);
+	return a <= c ? a <= b && b <= c : a <= b || b <= c;
+}
+
+void tour::reverse(std::size_t first, std::size_t last) {
+	Expects(first <= last);
+	Expects(last <= size());
+	value_type prefix, middle, suffix;
+	split(root, last, prefix, suffix);
+	split(prefix, first, prefix, middle);
+	flip(middle);
+	root = merge(merge(prefix, middle), suffix);
+}
+
+void tour::relocate(std::size_t from, std::size_t to) {
+	Expects(from < size());
+	Expects(to < size());
+	value_type prefix, element, suffix;
+	split(root, from, prefix, suffix);
+	split(suffix, 1, element, suffix);
+	root = merge(prefix, suffix);
+	split(root, to, prefix, suffix);
+	root = merge(merge(prefix, element), suffix);
+}
+
+void tour::swap(std::size_t lhs, std::size_t rhs) {
+	Expects(lhs < size());
+	Expects(rhs < size());
+	if (lhs == rhs)
+		return;
+	if (lhs > rhs)
+		std::swap(lhs, rhs);
+	value_type prefix, left, middle, right, suffix;
+	split(root, rhs, prefix, suffix);
+	split(suffix, 1, right, suffix);
+	split(prefix, lhs, prefix, middle);
+	split(middle, 1, left, middle);
+	root = merge(merge(merge(prefix, right), merge(middle, left)), suffix);
+}
+
+permutation tour::to_permutation() const {
+	permutation result;
+	result.reserve(size());
+	for_each([&](value_type city) {
+		result.push_back(city);
+	});
+	Ensures(result.size() == size());
+	return result;
+}
+
+unsigned tour::subtree_size(value_type index) const noexcept {
+	return index == none ? 0 : nodes[index].size;
+}
+
+void tour::flip(value_type index) noexcept {
+	if (index != none)
+		nodes[index].reversed = !nodes[index].reversed;
+}
+
+void tour::push(value_type index) noexcept {
+	node& n = nodes[index];
+	if (n.reversed) {
+		std::swap(n.left, n.right);
+		flip(n.left);
+		flip(n.right);
+		n.reversed = false;
+	}
+}
+
+void tour::update(value_type index) noexcept {
+	node& n = nodes[index];
+	n.size = 1 + subtree_size(n.left) + subtree_size(n.right);
+	n.parent = none;
+	if (n.left != none)
+		nodes[n.left].parent = index;
+	if (n.right != none)
+		nodes[n.right].parent = index;
+}
+
+void tour::split(value_type index, std::size_t count, value_type& left, value_type& right) {
+	if (index == none) {
+		left = right = none;
+		return;
+	}
+	push(index);
+	node& n = nodes[index];
+	if (subtree_size(n.left) >= count) {
+		split(n.left, count, left, n.left);
+		right = index;
+	} else {
+		split(n.right, count - subtree_size(n.left) - 1, n.right, right);
+		left = index;
+	}
+	update(index);
+}
+
+auto tour::merge(value_type left, value_type right) -> value_type {
+	if (left == none)
+		return right;
+	if (right == none)
+		return left;
+	if (nodes[left].priority > nodes[right].priority) {
+		push(left);
+		nodes[left].right = merge(nodes[left].right, right);
+		update(left);
+		return left;
+	} else {
+		push(right);
+		nodes[right].left = merge(left, nodes[right].left);
+		update(right);
+		return right;
+	}
+}
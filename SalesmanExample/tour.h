@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SALESMAN_EXAMPLE_TOUR_H
+#define SALESMAN_EXAMPLE_TOUR_H
+
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <vector>
+#include "permutation.h"
+
+/// A cyclic sequence of cities supporting logarithmic segment reversal and relocation
+/**
+The cities are kept in an implicit treap whose nodes are indexed by city,
+with lazily propagated reversal flags. Positions are zero-based offsets
+from the first city of the sequence, which is an arbitrary but fixed
+starting point of the cycle.
+*/
+class tour {
+public:
+	using value_type = unsigned;
+	tour() = default;
+	explicit tour(const permutation& perm);
+	std::size_t size() const noexcept;
+	bool empty() const noexcept;
+	value_type at(std::size_t index) const;
+	std::size_t position(value_type city) const;
+	value_type next(value_type city) const;
+	value_type prev(value_type city) const;
+	bool between(value_type first, value_type middle, value_type last) const;
+	void reverse(std::size_t first, std::size_t last);
+	void relocate(std::size_t from, std::size_t to);
+	void swap(std::size_t lhs, std::size_t rhs);
+	permutation to_permutation() const;
+	template<class Function>
+	void for_each(Function f) const;
+private:
+	static constexpr value_type none = std::numeric_limits<value_type>::max();
+	struct node {
+		value_type left = none;
+		value_type right = none;
+		value_type parent = none;
+		unsigned priority = 0;
+		unsigned size = 1;
+		bool reversed = false;
+	};
+	unsigned subtree_size(value_type index) const noexcept;
+	void flip(value_type index) noexcept;
+	void push(value_type index) noexcept;
+	void update(value_type index) noexcept;
+	void split(value_type index, std::size_t count, value_type& left, value_type& right);
+	value_type merge(value_type left, value_type right);
+	template<class Function>
+	void for_each(value_type index, bool reversed, Function& f) const;
+	std::vector<node> nodes;
+	value_type root = none;
+};
+
+template<class Function>
+inline void tour::for_each(Function f) const {
+	for_each(root, false, f);
+}
+
+template<class Function>
+inline void tour::for_each(value_type index, bool reversed, Function& f) const {
+	if (index == none)
+		return;
+	const node& current = nodes[index];
+	reversed ^= current.reversed;
+	for_each(reversed ? current.right : current.left, reversed, f);
+	f(index);
+	for_each(reversed ? current.left : current.right, reversed, f);
+}
+
+template<class CharT, class Traits>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const tour& t) {
+	return os << t.to_permutation();
+}
+
+#endif
@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SALESMAN_EXAMPLE_TOUR_CONSTRUCTION_H
+#define SALESMAN_EXAMPLE_TOUR_CONSTRUCTION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_assert>
+#include <gsl/gsl_util>
+#include "candidate_list.h"
+#include "disjoint_set_data_structure.h"
+
+template<class Permutation, class Cities>
+Permutation to_permutation(const Cities& cities) {
+	Permutation result(cities.size());
+	std::copy(cities.begin(), cities.end(), result.begin());
+	return result;
+}
+
+/// Nearest neighbour tour from a random city, sometimes taking a farther neighbour
+/**
+Every step moves to the k-th nearest unvisited city, where k is drawn
+from the geometric distribution with success probability \a greediness,
+so most steps are greedy and the tours still differ from one another.
+*/
+template<class Permutation, class Matrix, class UniformRandomBitGenerator>
+Permutation nearest_neighbor_tour(const Matrix& matrix, UniformRandomBitGenerator& rand, double greediness = 0.75) {
+	using index_type = typename Permutation::value_type;
+	const std::size_t size = matrix.size();
+	Expects(size > 0);
+	Expects(size - 1 <= std::numeric_limits<index_type>::max());
+	Expects(greediness > 0.0 && greediness <= 1.0);
+	std::vector<index_type> remaining(size);
+	std::iota(remaining.begin(), remaining.end(), index_type());
+	std::vector<index_type> cities;
+	cities.reserve(size);
+	index_type current = index_type(std::uniform_int_distribution<std::size_t>(0, size - 1)(rand));
+	gsl::at(remaining, current) = remaining.back();
+	remaining.pop_back();
+	cities.push_back(current);
+	std::geometric_distribution<std::size_t> rank(greediness);
+	while (!remaining.empty()) {
+		const auto& row = gsl::at(matrix, current);
+		const auto closer = [&](index_type lhs, index_type rhs) {
+			return gsl::at(row, lhs) < gsl::at(row, rhs);
+		};
+		const auto nth = std::next(remaining.begin(), std::min(rank(rand), remaining.size() - 1));
+		std::nth_element(remaining.begin(), nth, remaining.end(), closer);
+		current = *nth;
+		*nth = remaining.back();
+		remaining.pop_back();
+		cities.push_back(current);
+	}
+	return to_permutation<Permutation>(cities);
+}
+
+/// Greedy matching of the shortest candidate edges, with the fragments joined nearest first
+/**
+The edges of the candidate list are taken from the shortest, with every
+length stretched by a random factor of up to 1 + \a noise, as long as
+both ends still have degree below two and the edge closes no cycle. The
+resulting paths are then walked one after another, each continued to
+the nearest free end of a path that was not visited yet.
+*/
+template<class Permutation, class Matrix, class UniformRandomBitGenerator>
+Permutation greedy_edge_tour(const Matrix& matrix, const candidate_list& candidates, UniformRandomBitGenerator& rand, double noise = 0.1) {
+	using index_type = typename Permutation::value_type;
+	constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+	const std::size_t size = matrix.size();
+	Expects(size > 0);
+	Expects(size - 1 <= std::numeric_limits<index_type>::max());
+	Expects(candidates.size() == size);
+	Expects(noise >= 0.0);
+	std::uniform_real_distribution<double> stretch(1.0, 1.0 + noise);
+	std::vector<std::tuple<double, std::size_t, std::size_t>> edges;
+	edges.reserve(size * candidates.width());
+	for (std::size_t city = 0; city < size; city++) {
+		for (const unsigned neighbor : candidates[city]) {
+			const auto reverse = candidates[neighbor];
+			if (city < neighbor || std::find(reverse.begin(), reverse.end(), city) == reverse.end())
+				edges.emplace_back(gsl::at(gsl::at(matrix, city), neighbor) * stretch(rand), city, neighbor);
+		}
+	}
+	std::sort(edges.begin(), edges.end());
+	std::vector<std::pair<std::size_t, std::size_t>> links(size, {none, none});
+	const auto degree = [&](std::size_t city) {
+		return (gsl::at(links, city).first != none) + (gsl::at(links, city).second != none);
+	};
+	const auto link = [&](std::size_t from, std::size_t to) {
+		auto& [first, second] = gsl::at(links, from);
+		(first == none ? first : second) = to;
+	};
+	disjoint_set_data_structure fragments(size);
+	for (const auto& [length, lhs, rhs] : edges) {
+		if (degree(lhs) < 2 && degree(rhs) < 2 && fragments.merge(lhs, rhs)) {
+			link(lhs, rhs);
+			link(rhs, lhs);
+		}
+	}
+	std::vector<bool> visited(size);
+	std::vector<index_type> cities;
+	cities.reserve(size);
+	std::size_t current = none;
+	for (std::size_t city = 0; city < size && current == none; city++) {
+		if (degree(city) < 2)
+			current = city;
+	}
+	while (current != none) {
+		for (std::size_t next = current; next != none; ) {
+			current = next;
+			visited[current] = true;
+			cities.push_back(index_type(current));
+			const auto [first, second] = gsl::at(links, current);
+			next = first != none && !visited[first] ? first : second != none && !visited[second] ? second : none;
+		}
+		const auto& row = gsl::at(matrix, current);
+		std::size_t nearest = none;
+		for (std::size_t city = 0; city < size; city++) {
+			if (!visited[city] && degree(city) < 2 && (nearest == none || gsl::at(row, city) < gsl::at(row, nearest)))
+				nearest = city;
+		}
+		current = nearest;
+	}
+	Ensures(cities.size() == size);
+	return to_permutation<Permutation>(cities);
+}
+
+/// Distance of a grid cell along the Hilbert curve filling a square of side 2^\a order
+constexpr std::uint64_t hilbert_curve_index(std::uint32_t x, std::uint32_t y, unsigned order) noexcept {
+	const std::uint32_t side = std::uint32_t(1) << order;
+	std::uint64_t result = 0;
+	for (std::uint32_t s = side / 2; s > 0; s /= 2) {
+		const std::uint32_t rx = (x & s) != 0;
+		const std::uint32_t ry = (y & s) != 0;
+		result += std::uint64_t(s) * s * ((3 * rx) ^ ry);
+		if (ry == 0) {
+			if (rx == 1) {
+				x = side - 1 - x;
+				y = side - 1 - y;
+			}
+			std::swap(x, y);
+		}
+	}
+	return result;
+}
+
+/// Cities in the order of a Hilbert curve laid over the randomly rotated plane
+/**
+Needs only coordinates and runs in O(n log n), at the price of tours
+noticeably longer than the nearest neighbour ones. The rotation
+makes every call visit the cities in a different order.
+*/
+template<class Permutation, class UniformRandomBitGenerator>
+Permutation space_filling_curve_tour(const std::vector<std::pair<double, double>>& positions, UniformRandomBitGenerator& rand) {
+	using index_type = typename Permutation::value_type;
+	constexpr unsigned order = 16;
+	const std::size_t size = positions.size();
+	Expects(size > 0);
+	Expects(size - 1 <= std::numeric_limits<index_type>::max());
+	const double angle = std::uniform_real_distribution<double>(0.0, 2.0 * 3.14159265358979323846)(rand);
+	const double cos = std::cos(angle);
+	const double sin = std::sin(angle);
+	std::vector<std::pair<double, double>> rotated(size);
+	std::transform(positions.begin(), positions.end(), rotated.begin(), [&](const std::pair<double, double>& position) {
+		const auto& [x, y] = position;
+		return std::make_pair(x * cos - y * sin, x * sin + y * cos);
+	});
+	const auto [left, right] = std::minmax_element(rotated.begin(), rotated.end(), [](const auto& lhs, const auto& rhs) {
+		return lhs.first < rhs.first;
+	});
+	const auto [bottom, top] = std::minmax_element(rotated.begin(), rotated.end(), [](const auto& lhs, const auto& rhs) {
+		return lhs.second < rhs.second;
+	});
+	const double extent = std::max({right->first - left->first, top->second - bottom->second, std::numeric_limits<double>::min()});
+	const double scale = ((std::uint32_t(1) << order) - 1) / extent;
+	const double x0 = left->first;
+	const double y0 = bottom->second;
+	std::vector<std::pair<std::uint64_t, index_type>> keys(size);
+	for (std::size_t city = 0; city < size; city++) {
+		const auto& [x, y] = rotated[city];
+		keys[city] = {hilbert_curve_index(std::uint32_t((x - x0) * scale), std::uint32_t((y - y0) * scale), order), index_type(city)};
+	}
+	std::sort(keys.begin(), keys.end());
+	Permutation result(size);
+	std::transform(keys.begin(), keys.end(), result.begin(), [](const auto& key) {
+		return key.second;
+	});
+	return result;
+}
+
+/// Random insertion: cities in random order, each inserted where it lengthens the cycle least
+template<class Permutation, class Matrix, class UniformRandomBitGenerator>
+Permutation insertion_tour(const Matrix& matrix, UniformRandomBitGenerator& rand) {
+	using index_type = typename Permutation::value_type;
+	const std::size_t size = matrix.size();
+	Expects(size > 0);
+	Expects(size - 1 <= std::numeric_limits<index_type>::max());
+	std::vector<index_type> order(size);
+	std::iota(order.begin(), order.end(), index_type());
+	std::shuffle(order.begin(), order.end(), rand);
+	const auto distance = [&](std::size_t src, std::size_t dest) {
+		return gsl::at(gsl::at(matrix, src), dest);
+	};
+	std::vector<index_type> cities;
+	cities.reserve(size);
+	cities.push_back(order.front());
+	std::for_each(std::next(order.begin()), order.end(), [&](index_type city) {
+		std::size_t best = 0;
+		auto best_delta = distance(cities.back(), city) + distance(city, cities.front()) - distance(cities.back(), cities.front());
+		for (std::size_t i = 1; i < cities.size(); i++) {
+			const auto delta = distance(cities[i - 1], city) + distance(city, cities[i]) - distance(cities[i - 1], cities[i]);
+			if (delta < best_delta) {
+				best = i;
+				best_delta = delta;
+			}
+		}
+		cities.insert(std::next(cities.begin(), best), city);
+	});
+	return to_permutation<Permutation>(cities);
+}
+
+/// Builds every tour with one of the construction heuristics, chosen at random
+/**
+Calls with the same engine state give the same tour and the seeder itself
+is never modified, so it can be shared by the threads of a
+\c parallel_generator. The space-filling curve is used only when
+coordinates are given.
+*/
+template<class Permutation, class Matrix>
+class tour_seeder {
+public:
+	using permutation_type = Permutation;
+	using matrix_type = Matrix;
+	tour_seeder(const matrix_type& matrix, const candidate_list& candidates, const std::vector<std::pair<double, double>>& positions = {});
+	template<class UniformRandomBitGenerator>
+	permutation_type operator()(UniformRandomBitGenerator& rand) const;
+private:
+	matrix_type matrix;
+	candidate_list candidates;
+	std::vector<std::pair<double, double>> positions;
+};
+
+template<class Permutation, class Matrix>
+inline tour_seeder<Permutation, Matrix>::tour_seeder(const matrix_type& matrix, const candidate_list& candidates, const std::vector<std::pair<double, double>>& positions)
+	: matrix(matrix), candidates(candidates), positions(positions) {
+	Expects(candidates.size() == matrix.size());
+	Expects(positions.empty() || positions.size() == matrix.size());
+}
+
+template<class Permutation, class Matrix>
+template<class UniformRandomBitGenerator>
+inline auto tour_seeder<Permutation, Matrix>::operator()(UniformRandomBitGenerator& rand) const -> permutation_type {
+	switch (std::uniform_int_distribution<int>(0, positions.empty() ? 2 : 3)(rand)) {
+		case 0:
+			return nearest_neighbor_tour<permutation_type>(matrix, rand);
+		case 1:
+			return greedy_edge_tour<permutation_type>(matrix, candidates, rand);
+		case 2:
+			return insertion_tour<permutation_type>(matrix, rand);
+		default:
+			return space_filling_curve_tour<permutation_type>(positions, rand);
+	}
+}
+
+#endif
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2018 Jan Filipowicz, Filip Turobos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SALESMAN_EXAMPLE_TOUR_HASH_H
+#define SALESMAN_EXAMPLE_TOUR_HASH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include <gsl/gsl_assert>
+#include "tour.h"
+
+/// Hashes a cycle of cities independently of its starting city and direction.
+/**
+The cycle is read from its smallest city towards the smaller of that
+city's two neighbours, so all rotations and reflections of a tour, which
+have the same length, get the same hash. The cities are combined with a
+polynomial hash modulo 2^64 and the result is mixed with the splitmix64
+finalizer.
+*/
+class canonical_tour_hash {
+public:
+	template<class Permutation>
+	std::uint64_t operator()(const Permutation& perm) const;
+	std::uint64_t operator()(const tour& path) const;
+private:
+	static constexpr std::uint64_t multiplier = 0x100000001b3;
+	template<class Iterator>
+	static std::uint64_t combine(std::uint64_t hash, Iterator first, Iterator last) noexcept;
+	static constexpr std::uint64_t finalize(std::uint64_t hash) noexcept;
+};
+
+template<class Permutation>
+inline std::uint64_t canonical_tour_hash::operator()(const Permutation& perm) const {
+	Expects(!perm.empty());
+	const auto first = perm.begin();
+	const auto last = perm.end();
+	const auto start = std::min_element(first, last);
+	const auto next = std::next(start) == last ? first : std::next(start);
+	const auto prev = std::prev(start == first ? last : start);
+	std::uint64_t hash = 0;
+	if (*next <= *prev) {
+		hash = combine(hash, start, last);
+		hash = combine(hash, first, start);
+	} else {
+		using reverse_iterator = std::reverse_iterator<typename Permutation::const_iterator>;
+		hash = combine(hash, reverse_iterator(std::next(start)), reverse_iterator(first));
+		hash = combine(hash, reverse_iterator(last), reverse_iterator(std::next(start)));
+	}
+	return finalize(hash);
+}
+
+inline std::uint64_t canonical_tour_hash::operator()(const tour& path) const {
+	std::vector<tour::value_type> cities;
+	cities.reserve(path.size());
+	path.for_each([&](tour::value_type city) {
+		cities.push_back(city);
+	});
+	return (*this)(cities);
+}
+
+template<class Iterator>
+inline std::uint64_t canonical_tour_hash::combine(std::uint64_t hash, Iterator first, Iterator last) noexcept {
+	for (; first != last; ++first) {
+		hash = hash * multiplier + std::uint64_t(*first) + 1;
+	}
+	return hash;
+}
+
+constexpr std::uint64_t canonical_tour_hash::finalize(std::uint64_t hash) noexcept {
+	hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+	hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+	return hash ^ (hash >> 31);
+}
+
+#endif